@@ -0,0 +1,102 @@
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+// Minimal benchmark harness: cases register themselves with BENCH_CASE and
+// report timings through bench::measure(). Run `engine_bench [filter]`; with
+// `--json FILE` every measurement is also written in Google Benchmark's JSON
+// format, so results can be compared between builds.
+namespace bench {
+
+using CaseFn = void (*)();
+
+struct Case {
+    const char* name;
+    CaseFn fn;
+};
+
+inline std::vector<Case>& registry() {
+    static std::vector<Case> cases;
+    return cases;
+}
+
+// One bench::measure() call
+struct Result {
+    std::string caseName;
+    std::string label;
+    size_t operations;
+    int repetitions;
+    double bestNs; // Fastest repetition
+    double meanNs;
+};
+
+inline std::vector<Result>& results() {
+    static std::vector<Result> measured;
+    return measured;
+}
+
+// Set by the runner while a case runs
+inline std::string& currentCase() {
+    static std::string name;
+    return name;
+}
+
+struct Registrar {
+    Registrar(const char* name, CaseFn fn) { registry().push_back({name, fn}); }
+};
+
+// Prevents the optimizer from discarding a computed value
+template<typename T>
+inline void doNotOptimize(const T& value) {
+#if defined(__GNUC__) || defined(__clang__)
+    asm volatile("" : : "r,m"(value) : "memory");
+#else
+    static volatile const T* sink;
+    sink = &value;
+#endif
+}
+
+// Runs `body` several times and reports the fastest run as ns per operation.
+// `setup` runs untimed before every repetition so each one starts from the same state.
+// Returns the fastest run in nanoseconds.
+template<typename Setup, typename Body>
+inline double measure(const std::string& label, size_t operations, Setup&& setup, Body&& body,
+                    int repetitions = 5) {
+    double bestNs = 0.0;
+    double totalNs = 0.0;
+    for (int rep = 0; rep < repetitions; ++rep) {
+        setup();
+        auto start = std::chrono::steady_clock::now();
+        body();
+        auto end = std::chrono::steady_clock::now();
+        double ns = std::chrono::duration<double, std::nano>(end - start).count();
+        if (rep == 0 || ns < bestNs) {
+            bestNs = ns;
+        }
+        totalNs += ns;
+    }
+    std::printf("  %-48s %12.2f ns/op %14.3f ms total\n", label.c_str(),
+                bestNs / static_cast<double>(std::max<size_t>(operations, 1)), bestNs / 1e6);
+    results().push_back({currentCase(), label, operations, repetitions, bestNs,
+                         totalNs / std::max(repetitions, 1)});
+    return bestNs;
+}
+
+template<typename Body>
+inline double measure(const std::string& label, size_t operations, Body&& body,
+                      int repetitions = 5) {
+    return measure(label, operations, [] {}, body, repetitions);
+}
+
+} // namespace bench
+
+#define BENCH_CAT_IMPL(a, b) a##b
+#define BENCH_CAT(a, b) BENCH_CAT_IMPL(a, b)
+#define BENCH_CASE(name)                                                        \
+    static void BENCH_CAT(benchCase_, __LINE__)();                              \
+    static bench::Registrar BENCH_CAT(benchRegistrar_, __LINE__)(               \
+        name, &BENCH_CAT(benchCase_, __LINE__));                                \
+    static void BENCH_CAT(benchCase_, __LINE__)()
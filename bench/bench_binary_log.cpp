@@ -0,0 +1,42 @@
+#include "Bench.h"
+#include "engine/core/BinaryLog.h"
+#include "engine/core/Logger.h"
+#include <cstdio>
+#include <string>
+
+// Per-event cost of binary logging against text logging of the same event
+namespace {
+
+constexpr int EVENTS = 200000;
+const char* const BINARY_LOG_PATH = "bench_binary_log.bin";
+
+} // namespace
+
+BENCH_CASE("BinaryLog: per-event cost against text logging") {
+    bench::measure(
+        "ENGINE_BINARY_LOG", EVENTS,
+        [] { engine::BinaryLog::Open(BINARY_LOG_PATH); },
+        [] {
+            for (int i = 0; i < EVENTS; ++i) {
+                ENGINE_BINARY_LOG(engine::LogLevel::INFO, "entity {} moved to {}, {}", i,
+                                  i * 0.5f, -i * 0.25f);
+            }
+        });
+    engine::BinaryLog::Close();
+    std::remove(BINARY_LOG_PATH);
+
+    engine::LoggerConfig config;
+    config.console = false;
+    config.filePath = "/dev/null";
+    config.async = true;
+    config.overflow = engine::LogOverflow::BLOCK;
+    config.queueCapacity = EVENTS;
+    bench::measure(
+        "Logger::Info, async", EVENTS, [&] { engine::Logger::Init(config); },
+        [] {
+            for (int i = 0; i < EVENTS; ++i) {
+                engine::Logger::Info("entity ", i, " moved to ", i * 0.5f, ", ", -i * 0.25f);
+            }
+        });
+    engine::Logger::Shutdown();
+}
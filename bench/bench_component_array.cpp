@@ -0,0 +1,106 @@
+#include "Bench.h"
+#include "engine/ecs/World.h"
+#include "game/components/GameComponents.h"
+#include <array>
+#include <numeric>
+#include <random>
+#include <unordered_map>
+
+namespace {
+
+constexpr size_t ENTITY_COUNT = 10000;
+
+// The previous ComponentArray implementation (two unordered_maps), kept here
+// as the baseline the sparse set is measured against.
+template<typename T>
+class MapComponentArray {
+public:
+    void insertData(engine::EntityId entity, T component) {
+        size_t newIndex = size;
+        entityToIndexMap[entity] = newIndex;
+        indexToEntityMap[newIndex] = entity;
+        componentArray[newIndex] = component;
+        size++;
+    }
+
+    void removeData(engine::EntityId entity) {
+        size_t indexOfRemovedEntity = entityToIndexMap[entity];
+        size_t indexOfLastElement = size - 1;
+        componentArray[indexOfRemovedEntity] = componentArray[indexOfLastElement];
+
+        engine::EntityId entityOfLastElement = indexToEntityMap[indexOfLastElement];
+        entityToIndexMap[entityOfLastElement] = indexOfRemovedEntity;
+        indexToEntityMap[indexOfRemovedEntity] = entityOfLastElement;
+
+        entityToIndexMap.erase(entity);
+        indexToEntityMap.erase(indexOfLastElement);
+        size--;
+    }
+
+    T& getData(engine::EntityId entity) { return componentArray[entityToIndexMap[entity]]; }
+
+    bool hasData(engine::EntityId entity) const {
+        return entityToIndexMap.find(entity) != entityToIndexMap.end();
+    }
+
+private:
+    std::array<T, ENTITY_COUNT> componentArray;
+    std::unordered_map<engine::EntityId, size_t> entityToIndexMap;
+    std::unordered_map<size_t, engine::EntityId> indexToEntityMap;
+    size_t size = 0;
+};
+
+std::vector<engine::EntityId> shuffledEntities() {
+    std::vector<engine::EntityId> ids(ENTITY_COUNT);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::shuffle(ids.begin(), ids.end(), std::mt19937(42));
+    return ids;
+}
+
+template<typename Array>
+void runComponentArrayBench(const char* backend) {
+    const auto order = shuffledEntities();
+    auto array = std::make_unique<Array>();
+    const std::string prefix = std::string(backend) + " ";
+
+    bench::measure(prefix + "insertData x10k", ENTITY_COUNT,
+        [&] { array = std::make_unique<Array>(); },
+        [&] {
+            for (engine::EntityId entity : order) {
+                array->insertData(entity, game::Transform{1.0f, 2.0f, 0.0f});
+            }
+        });
+
+    bench::measure(prefix + "hasData+getData x10k", ENTITY_COUNT, [&] {
+        float sum = 0.0f;
+        for (engine::EntityId entity : order) {
+            if (array->hasData(entity)) {
+                sum += array->getData(entity).x;
+            }
+        }
+        bench::doNotOptimize(sum);
+    });
+
+    bench::measure(prefix + "removeData x10k", ENTITY_COUNT,
+        [&] {
+            array = std::make_unique<Array>();
+            for (engine::EntityId entity = 0; entity < ENTITY_COUNT; ++entity) {
+                array->insertData(entity, game::Transform{1.0f, 2.0f, 0.0f});
+            }
+        },
+        [&] {
+            for (engine::EntityId entity : order) {
+                array->removeData(entity);
+            }
+        });
+}
+
+} // namespace
+
+BENCH_CASE("ComponentArray: unordered_map baseline") {
+    runComponentArrayBench<MapComponentArray<game::Transform>>("map");
+}
+
+BENCH_CASE("ComponentArray: sparse set") {
+    runComponentArrayBench<engine::ComponentArray<game::Transform>>("sparse");
+}
@@ -0,0 +1,73 @@
+#include "Bench.h"
+#include "engine/ecs/World.h"
+#include "game/components/GameComponents.h"
+#include <typeinfo>
+#include <unordered_map>
+
+// Per-access overhead of resolving a component pool: the previous
+// typeid-name hash map returning shared_ptr copies vs the flat array
+// indexed by component type ID.
+namespace {
+
+constexpr size_t ENTITY_COUNT = 10000;
+
+// Reproduces World::getComponentArray<T>() before the flat registry
+class TypeNameRegistry {
+public:
+    template<typename T>
+    void registerComponent() {
+        arrays.insert({typeid(T).name(), std::make_shared<engine::ComponentArray<T>>()});
+    }
+
+    template<typename T>
+    std::shared_ptr<engine::ComponentArray<T>> getComponentArray() {
+        return std::static_pointer_cast<engine::ComponentArray<T>>(arrays[typeid(T).name()]);
+    }
+
+private:
+    std::unordered_map<const char*, std::shared_ptr<engine::IComponentArray>> arrays;
+};
+
+} // namespace
+
+BENCH_CASE("Component lookup: typeid map vs flat registry") {
+    TypeNameRegistry registry;
+    registry.registerComponent<game::Transform>();
+    registry.registerComponent<game::Velocity>();
+
+    engine::World world;
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::Velocity>();
+
+    for (size_t i = 0; i < ENTITY_COUNT; ++i) {
+        engine::EntityId entity = world.createEntity();
+        game::Transform transform{1.0f, 0.0f, 0.0f};
+        world.addComponent(entity, transform);
+        registry.getComponentArray<game::Transform>()->insertData(entity, transform);
+        if (i % 2 == 0) {
+            game::Velocity velocity{1.0f, 0.0f};
+            world.addComponent(entity, velocity);
+            registry.getComponentArray<game::Velocity>()->insertData(entity, velocity);
+        }
+    }
+
+    bench::measure("typeid map hasComponent+getComponent x10k", ENTITY_COUNT, [&] {
+        float sum = 0.0f;
+        for (engine::EntityId entity = 0; entity < ENTITY_COUNT; ++entity) {
+            if (registry.getComponentArray<game::Velocity>()->hasData(entity)) {
+                sum += registry.getComponentArray<game::Transform>()->getData(entity).x;
+            }
+        }
+        bench::doNotOptimize(sum);
+    });
+
+    bench::measure("flat registry hasComponent+getComponent x10k", ENTITY_COUNT, [&] {
+        float sum = 0.0f;
+        for (engine::EntityId entity = 0; entity < ENTITY_COUNT; ++entity) {
+            if (world.hasComponent<game::Velocity>(entity)) {
+                sum += world.getComponent<game::Transform>(entity).x;
+            }
+        }
+        bench::doNotOptimize(sum);
+    });
+}
@@ -0,0 +1,75 @@
+#include "Bench.h"
+#include "engine/ecs/DeltaSnapshot.h"
+#include "game/components/GameComponents.h"
+#include <vector>
+
+// Bytes per tick of delta snapshots against full snapshots, with a small
+// fraction of entities moving each tick
+namespace {
+
+void runDeltaBench(size_t entityCount, size_t movingEvery, bool tracked) {
+    engine::World world;
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::Velocity>();
+    world.registerComponent<game::Enemy>();
+    if (tracked) {
+        world.enableChangeTracking<game::Transform>();
+        world.enableChangeTracking<game::Velocity>();
+        world.enableChangeTracking<game::Enemy>();
+    }
+
+    std::vector<engine::EntityId> moving;
+    for (size_t i = 0; i < entityCount; ++i) {
+        engine::EntityId entity = world.createEntity();
+        float f = static_cast<float>(i);
+        world.addComponent(entity, game::Transform{f, -f, 0.0f});
+        world.addComponent(entity, game::Enemy{});
+        if (i % movingEvery == 0) {
+            world.addComponent(entity, game::Velocity{0.5f, -0.25f});
+            moving.push_back(entity);
+        }
+    }
+
+    engine::ReplicationSchema schema;
+    schema.add<game::Transform>({0.01f, 0.01f, 0.001f});
+    schema.add<game::Velocity>({0.01f, 0.01f});
+    schema.add<game::Enemy>();
+    engine::DeltaEncoder encoder(schema);
+
+    std::vector<std::byte> full;
+    world.saveSnapshot(full);
+    std::vector<std::byte> delta;
+    encoder.encode(world, delta);
+    size_t firstBytes = delta.size();
+
+    constexpr int TICKS = 20;
+    size_t deltaBytes = 0;
+    std::string label = std::string(tracked ? "encode tracked x" : "encode compare x") +
+                        std::to_string(entityCount);
+    bench::measure(
+        label, entityCount * TICKS, [&] { deltaBytes = 0; },
+        [&] {
+            for (int tick = 0; tick < TICKS; ++tick) {
+                for (engine::EntityId entity : moving) {
+                    auto& transform = world.getComponent<game::Transform>(entity);
+                    transform.x += 0.5f / 60.0f;
+                    transform.y -= 0.25f / 60.0f;
+                }
+                delta.clear();
+                encoder.encode(world, delta);
+                deltaBytes += delta.size();
+            }
+        });
+
+    double perTick = static_cast<double>(deltaBytes) / TICKS;
+    std::printf("    full snapshot %zu bytes, first delta %zu bytes, %.0f bytes/tick "
+                "(%.1fx smaller)\n",
+                full.size(), firstBytes, perTick, static_cast<double>(full.size()) / perTick);
+}
+
+} // namespace
+
+BENCH_CASE("DeltaSnapshot: encode with 5% of entities moving") {
+    runDeltaBench(10000, 20, false);
+    runDeltaBench(10000, 20, true);
+}
@@ -0,0 +1,170 @@
+#include "Bench.h"
+#include "engine/ecs/World.h"
+#include "engine/platform/Renderer.h"
+#include "engine/systems/MovementSystem.h"
+#include "engine/systems/RenderSystem.h"
+#include "game/components/GameComponents.h"
+#include <numeric>
+#include <random>
+
+// Core World operations and whole-system updates at 1k/10k/100k entities,
+// the numbers to watch for regressions (`engine_bench ECS --json out.json`).
+// RenderSystem draws into a Renderer built with ENGINE_NULL_RENDERER, so it
+// measures queueing and batching without a GL context.
+namespace {
+
+constexpr size_t ENTITY_COUNTS[] = {1000, 10000, 100000};
+constexpr float DT = 1.0f / 60.0f;
+
+std::string suffix(size_t count) {
+    return " x" + std::to_string(count / 1000) + "k";
+}
+
+void registerGameComponents(engine::World& world) {
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::PreviousTransform>();
+    world.registerComponent<game::Velocity>();
+    world.registerComponent<game::Renderable>();
+}
+
+// Moving, drawable entities spread over clip space
+std::vector<engine::EntityId> populate(engine::World& world, size_t count) {
+    std::mt19937 rng(42);
+    std::uniform_real_distribution<float> position(-0.9f, 0.9f);
+    std::uniform_real_distribution<float> speed(-0.5f, 0.5f);
+    std::vector<engine::EntityId> entities;
+    entities.reserve(count);
+    for (size_t i = 0; i < count; ++i) {
+        engine::EntityId entity = world.createEntity();
+        float x = position(rng), y = position(rng);
+        world.addComponent(entity, game::Transform{x, y, 0.0f});
+        world.addComponent(entity, game::PreviousTransform{x, y, 0.0f});
+        world.addComponent(entity, game::Velocity{speed(rng), speed(rng)});
+        game::Renderable renderable{};
+        renderable.shape = i % 2 ? game::Renderable::Shape::Circle
+                                 : game::Renderable::Shape::Rectangle;
+        renderable.r = renderable.g = renderable.b = 1.0f;
+        renderable.width = renderable.height = 0.01f;
+        renderable.layer = static_cast<int>(i % 4);
+        world.addComponent(entity, renderable);
+        entities.push_back(entity);
+    }
+    return entities;
+}
+
+} // namespace
+
+BENCH_CASE("ECS: entity churn") {
+    for (size_t count : ENTITY_COUNTS) {
+        engine::World world;
+        registerGameComponents(world);
+        std::vector<engine::EntityId> entities(count);
+
+        // Entities carry a Transform, so destroying one also removes a component.
+        // Every repetition after the first reuses freed ids.
+        bench::measure("create+destroy" + suffix(count), count * 2, [&] {
+            for (size_t i = 0; i < count; ++i) {
+                entities[i] = world.createEntity();
+                world.addComponent(entities[i], game::Transform{0.0f, 0.0f, 0.0f});
+            }
+            for (engine::EntityId entity : entities) {
+                world.destroyEntity(entity);
+            }
+        });
+    }
+}
+
+BENCH_CASE("ECS: component add/remove") {
+    for (size_t count : ENTITY_COUNTS) {
+        engine::World world;
+        registerGameComponents(world);
+        std::vector<engine::EntityId> entities(count);
+        for (size_t i = 0; i < count; ++i) {
+            entities[i] = world.createEntity();
+            world.addComponent(entities[i], game::Transform{0.0f, 0.0f, 0.0f});
+        }
+
+        bench::measure("add+remove Velocity" + suffix(count), count * 2, [&] {
+            for (engine::EntityId entity : entities) {
+                world.addComponent(entity, game::Velocity{1.0f, 1.0f});
+            }
+            for (engine::EntityId entity : entities) {
+                world.removeComponent<game::Velocity>(entity);
+            }
+        });
+    }
+}
+
+BENCH_CASE("ECS: getComponent") {
+    for (size_t count : ENTITY_COUNTS) {
+        engine::World world;
+        registerGameComponents(world);
+        std::vector<engine::EntityId> entities = populate(world, count);
+        std::shuffle(entities.begin(), entities.end(), std::mt19937(7));
+
+        bench::measure("random order" + suffix(count), count, [&] {
+            float sum = 0.0f;
+            for (engine::EntityId entity : entities) {
+                sum += world.getComponent<game::Transform>(entity).x;
+            }
+            bench::doNotOptimize(sum);
+        });
+    }
+}
+
+BENCH_CASE("ECS: view iteration") {
+    for (size_t count : ENTITY_COUNTS) {
+        engine::World world;
+        registerGameComponents(world);
+        populate(world, count);
+
+        bench::measure("1 component" + suffix(count), count, [&] {
+            float sum = 0.0f;
+            world.view<const game::Transform>().each(
+                [&](engine::EntityId, const game::Transform& transform) { sum += transform.x; });
+            bench::doNotOptimize(sum);
+        });
+        bench::measure("2 components" + suffix(count), count, [&] {
+            world.view<game::Transform, const game::Velocity>().each(
+                [](engine::EntityId, game::Transform& transform, const game::Velocity& velocity) {
+                transform.x += velocity.vx * DT;
+                transform.y += velocity.vy * DT;
+            });
+        });
+        bench::measure("3 components" + suffix(count), count, [&] {
+            world.view<game::Transform, const game::Velocity, game::PreviousTransform>().each(
+                [](engine::EntityId, game::Transform& transform, const game::Velocity& velocity,
+                   game::PreviousTransform& prev) {
+                prev.x = transform.x;
+                prev.y = transform.y;
+                transform.x += velocity.vx * DT;
+                transform.y += velocity.vy * DT;
+            });
+        });
+    }
+}
+
+BENCH_CASE("ECS: MovementSystem update") {
+    for (size_t count : ENTITY_COUNTS) {
+        engine::World world;
+        registerGameComponents(world);
+        populate(world, count);
+
+        engine::MovementSystem system;
+        bench::measure("update" + suffix(count), count, [&] { system.update(world, DT); });
+    }
+}
+
+BENCH_CASE("ECS: RenderSystem update (null renderer)") {
+    for (size_t count : ENTITY_COUNTS) {
+        engine::World world;
+        registerGameComponents(world);
+        populate(world, count);
+
+        Renderer renderer;
+        engine::RenderSystem system(renderer);
+        // Steady state: the first frame fills the layer buckets
+        system.update(world, 0.5f);
+        bench::measure("update" + suffix(count), count, [&] { system.update(world, 0.5f); });
+    }
+}
@@ -0,0 +1,107 @@
+#include "Bench.h"
+#include "engine/core/Logger.h"
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+// Cost of a log call on the calling thread, with several threads logging at
+// once. Output goes to /dev/null so only the Logger itself is measured.
+namespace {
+
+constexpr int CALLS_PER_THREAD = 20000;
+
+// `formatted` includes building the message from arguments in the caller
+void runLoggerBench(const char* label, const engine::LoggerConfig& config, bool formatted) {
+    for (int threads : {1, 2, 4}) {
+        bench::measure(
+            std::string(label) + " threads=" + std::to_string(threads),
+            static_cast<size_t>(CALLS_PER_THREAD) * threads,
+            [&] { engine::Logger::Init(config); },
+            [&] {
+                std::vector<std::thread> producers;
+                for (int t = 0; t < threads; ++t) {
+                    producers.emplace_back([t, formatted] {
+                        const std::string message = "entity 1234 moved to 0.5";
+                        for (int i = 0; i < CALLS_PER_THREAD; ++i) {
+                            if (formatted) {
+                                engine::Logger::Info("entity ", i, " moved to ", t * 0.5f);
+                            } else {
+                                engine::Logger::Log(engine::LogLevel::INFO, message);
+                            }
+                        }
+                    });
+                }
+                for (std::thread& producer : producers) {
+                    producer.join();
+                }
+            });
+        if (engine::Logger::GetDroppedCount() > 0) {
+            std::printf("    (last run dropped %llu records)\n",
+                        static_cast<unsigned long long>(engine::Logger::GetDroppedCount()));
+        }
+    }
+}
+
+} // namespace
+
+BENCH_CASE("Logger: ns per call under contention") {
+    engine::LoggerConfig config;
+    config.console = false;
+    config.filePath = "/dev/null";
+
+    runLoggerBench("sync", config, true);
+    runLoggerBench("sync, preformatted", config, false);
+
+    config.async = true;
+    config.overflow = engine::LogOverflow::DROP;
+    runLoggerBench("async drop", config, true);
+    runLoggerBench("async drop, preformatted", config, false);
+
+    config.overflow = engine::LogOverflow::BLOCK;
+    runLoggerBench("async block", config, true);
+    runLoggerBench("async block, preformatted", config, false);
+
+    engine::Logger::Shutdown();
+}
+
+namespace {
+
+template<typename... Args>
+std::string streamFormat(const Args&... args) {
+    std::stringstream ss;
+    (ss << ... << args);
+    return ss.str();
+}
+
+} // namespace
+
+BENCH_CASE("Logger: message formatting") {
+    constexpr int CALLS = 200000;
+    const std::string name = "goblin";
+
+    bench::measure("std::stringstream", CALLS, [&] {
+        for (int i = 0; i < CALLS; ++i) {
+            bench::doNotOptimize(
+                streamFormat("entity ", i, " (", name, ") moved to ", i * 0.5f, ", ", -i));
+        }
+    });
+
+    bench::measure("LogMessage", CALLS, [&] {
+        for (int i = 0; i < CALLS; ++i) {
+            engine::LogMessage message;
+            engine::Logger::FormatTo(message, "entity ", i, " (", name, ") moved to ", i * 0.5f,
+                                     ", ", -i);
+            bench::doNotOptimize(message.view().size());
+        }
+    });
+
+    // A call below the runtime threshold only loads the level
+    engine::Logger::SetLevel(engine::LogLevel::INFO);
+    bench::measure("Logger::Debug below threshold", CALLS, [&] {
+        for (int i = 0; i < CALLS; ++i) {
+            engine::Logger::Debug("entity ", i, " (", name, ") moved to ", i * 0.5f);
+        }
+    });
+    engine::Logger::SetLevel(engine::LogLevel::DEBUG);
+}
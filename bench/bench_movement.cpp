@@ -0,0 +1,46 @@
+#include "Bench.h"
+#include "engine/ecs/World.h"
+#include "engine/systems/MovementSystem.h"
+#include "game/components/GameComponents.h"
+
+// The full MovementSystem tick against a hand-written per-entity loop
+namespace {
+
+constexpr size_t ENTITY_COUNT = 100000;
+constexpr float DT = 1.0f / 60.0f;
+
+} // namespace
+
+BENCH_CASE("Movement: MovementSystem vs per-entity loop") {
+    engine::World world;
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::PreviousTransform>();
+    world.registerComponent<game::Velocity>();
+    for (size_t i = 0; i < ENTITY_COUNT; ++i) {
+        engine::EntityId entity = world.createEntity();
+        world.addComponent(entity, game::Transform{0.1f, -0.1f, 0.0f});
+        world.addComponent(entity, game::PreviousTransform{0.1f, -0.1f, 0.0f});
+        world.addComponent(entity, game::Velocity{0.5f, -0.5f});
+    }
+
+    bench::measure("per-entity AoS loop x100k", ENTITY_COUNT, [&] {
+        world.view<game::Transform, game::Velocity>().each(
+            [&](engine::EntityId entity, game::Transform& transform, game::Velocity& velocity) {
+            if (world.hasComponent<game::PreviousTransform>(entity)) {
+                auto& prev = world.getComponent<game::PreviousTransform>(entity);
+                prev.x = transform.x;
+                prev.y = transform.y;
+                prev.rotation = transform.rotation;
+            }
+            transform.x += velocity.vx * DT;
+            transform.y += velocity.vy * DT;
+            if (transform.x < -0.9f) transform.x = -0.9f;
+            if (transform.x > 0.9f) transform.x = 0.9f;
+            if (transform.y < -0.9f) transform.y = -0.9f;
+            if (transform.y > 0.9f) transform.y = 0.9f;
+        });
+    });
+
+    engine::MovementSystem system;
+    bench::measure("MovementSystem x100k", ENTITY_COUNT, [&] { system.update(world, DT); });
+}
@@ -0,0 +1,47 @@
+#include "Bench.h"
+#include "engine/core/ThreadPool.h"
+#include "engine/ecs/World.h"
+#include "engine/systems/MovementSystem.h"
+#include "game/components/GameComponents.h"
+
+// MovementSystem integration split across 1, 2, 4 and 8 threads
+// (the calling thread plus N-1 pool workers).
+namespace {
+
+constexpr float DT = 1.0f / 60.0f;
+
+void populate(engine::World& world, size_t count) {
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::PreviousTransform>();
+    world.registerComponent<game::Velocity>();
+    for (size_t i = 0; i < count; ++i) {
+        engine::EntityId entity = world.createEntity();
+        float offset = static_cast<float>(i % 1000) / 1000.0f - 0.5f;
+        world.addComponent(entity, game::Transform{offset, -offset, 0.0f});
+        world.addComponent(entity, game::PreviousTransform{offset, -offset, 0.0f});
+        world.addComponent(entity, game::Velocity{0.1f, -0.1f});
+    }
+}
+
+} // namespace
+
+BENCH_CASE("Parallel: MovementSystem thread scaling") {
+    for (size_t count : {100000u, 1000000u}) {
+        engine::World world;
+        populate(world, count);
+
+        double singleThreadNs = 0.0;
+        for (size_t threads : {1u, 2u, 4u, 8u}) {
+            engine::ThreadPool pool(threads - 1);
+            engine::MovementSystem system(&pool);
+
+            double ns = bench::measure(
+                "MovementSystem x" + std::to_string(count) + " threads=" + std::to_string(threads),
+                count, [&] { system.update(world, DT); });
+            if (threads == 1) {
+                singleThreadNs = ns;
+            }
+            std::printf("  %-48s %12.2fx\n", "  speedup vs 1 thread", singleThreadNs / ns);
+        }
+    }
+}
@@ -0,0 +1,32 @@
+#include "Bench.h"
+#include "engine/core/Profiler.h"
+
+// Cost of one ProfileScope: disabled, aggregating only, and while tracing
+namespace {
+
+constexpr int SCOPES = 1000000;
+
+void runScopes(engine::Profiler& profiler, uint32_t section) {
+    for (int i = 0; i < SCOPES; ++i) {
+        engine::ProfileScope scope(&profiler, section);
+        bench::doNotOptimize(i);
+    }
+}
+
+} // namespace
+
+BENCH_CASE("Profiler: ProfileScope overhead") {
+    engine::Profiler profiler;
+    uint32_t section = profiler.addSection("Scope");
+
+    bench::measure("disabled", SCOPES, [&] { runScopes(profiler, section); });
+
+    profiler.setEnabled(true);
+    bench::measure(
+        "enabled", SCOPES, [&] { profiler.collect(); }, [&] { runScopes(profiler, section); });
+
+    bench::measure(
+        "enabled + trace", SCOPES, [&] { profiler.startTrace(SCOPES); },
+        [&] { runScopes(profiler, section); });
+    profiler.writeTrace("/dev/null");
+}
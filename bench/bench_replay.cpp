@@ -0,0 +1,57 @@
+#include "Bench.h"
+#include "engine/core/InputRecorder.h"
+#include <cstdio>
+#include <string>
+
+// Opening and seeking a four-hour input recording (60 Hz)
+namespace {
+
+constexpr uint64_t SESSION_FRAMES = 4ull * 60 * 60 * 60;
+
+game::PlayerInput sessionInput(uint64_t frame) {
+    // Held keys changing every few frames, with idle stretches
+    if ((frame / 600) % 4 == 0) {
+        return game::PlayerInput{};
+    }
+    return engine::InputRecorder::UnpackInput(static_cast<uint8_t>((frame / 5) * 7 % 64));
+}
+
+} // namespace
+
+BENCH_CASE("Replay: open and seek a 4 hour recording") {
+    const char* filename = "bench_replay.bin";
+    {
+        engine::InputRecorder recorder;
+        recorder.StartRecording(filename);
+        for (uint64_t frame = 0; frame < SESSION_FRAMES; ++frame) {
+            game::PlayerInput input = sessionInput(frame);
+            recorder.ProcessInput(input);
+        }
+        recorder.StopRecording();
+    }
+
+    engine::InputRecorder player;
+    bench::measure("open", 1, [&] { player.StopPlayback(); },
+                   [&] { player.StartPlayback(filename); });
+
+    constexpr int SEEKS = 1000;
+    bench::measure("seek (indexed) x" + std::to_string(SEEKS), SEEKS, [&] {
+        for (int i = 0; i < SEEKS; ++i) {
+            bench::doNotOptimize(player.SeekToFrame(SESSION_FRAMES * i / SEEKS + 97));
+        }
+    });
+
+    // What a seek used to cost: play forward from frame 0
+    game::PlayerInput input;
+    bench::measure("seek (play from start) to last frame", 1, [&] {
+        player.SeekToFrame(0);
+        for (uint64_t frame = 0; frame + 1 < SESSION_FRAMES; ++frame) {
+            player.ProcessInput(input);
+        }
+        bench::doNotOptimize(input);
+    });
+    std::printf("    %llu frames\n", static_cast<unsigned long long>(SESSION_FRAMES));
+
+    player.StopPlayback();
+    std::remove(filename);
+}
@@ -0,0 +1,53 @@
+#include "Bench.h"
+#include "engine/ecs/World.h"
+#include "game/components/GameComponents.h"
+#include <vector>
+
+// World snapshot save/restore throughput and size
+namespace {
+
+void registerComponents(engine::World& world) {
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::PreviousTransform>();
+    world.registerComponent<game::Velocity>();
+    world.registerComponent<game::Enemy>();
+}
+
+void runSnapshotBench(size_t entityCount) {
+    engine::World world;
+    registerComponents(world);
+    for (size_t i = 0; i < entityCount; ++i) {
+        engine::EntityId entity = world.createEntity();
+        float f = static_cast<float>(i);
+        world.addComponent(entity, game::Transform{f, -f, 0.0f});
+        world.addComponent(entity, game::PreviousTransform{f, -f, 0.0f});
+        world.addComponent(entity, game::Velocity{0.1f, 0.2f});
+        world.addComponent(entity, game::Enemy{});
+    }
+
+    std::vector<std::byte> snapshot;
+    std::string suffix = " x" + std::to_string(entityCount);
+    double saveNs = bench::measure("save" + suffix, entityCount, [&] { snapshot.clear(); },
+                                   [&] { world.saveSnapshot(snapshot); });
+
+    std::unique_ptr<engine::World> restored;
+    double loadNs = bench::measure(
+        "load" + suffix, entityCount,
+        [&] {
+            restored = std::make_unique<engine::World>();
+            registerComponents(*restored);
+        },
+        [&] { bench::doNotOptimize(restored->loadSnapshot(snapshot.data(), snapshot.size())); });
+
+    double megabytes = static_cast<double>(snapshot.size()) / (1024.0 * 1024.0);
+    std::printf("    snapshot %.2f MB (%.1f bytes/entity), save %.0f MB/s, load %.0f MB/s\n",
+                megabytes, static_cast<double>(snapshot.size()) / entityCount,
+                megabytes / (saveNs / 1e9), megabytes / (loadNs / 1e9));
+}
+
+} // namespace
+
+BENCH_CASE("Snapshot: save and restore World") {
+    runSnapshotBench(10000);
+    runSnapshotBench(100000);
+}
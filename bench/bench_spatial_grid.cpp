@@ -0,0 +1,71 @@
+#include "Bench.h"
+#include "engine/ecs/SpatialGrid.h"
+#include <random>
+#include <vector>
+
+// Proximity queries through SpatialGrid versus scanning every position
+namespace {
+
+constexpr size_t ENTITY_COUNT = 100000;
+constexpr size_t QUERY_COUNT = 1000;
+
+struct Point {
+    float x, y;
+};
+
+} // namespace
+
+BENCH_CASE("SpatialGrid: rebuild and queries vs brute force") {
+    std::mt19937 rng(1);
+    std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+    std::vector<Point> points(ENTITY_COUNT);
+    for (auto& p : points) {
+        p = {position(rng), position(rng)};
+    }
+    std::vector<Point> queries(QUERY_COUNT);
+    for (auto& q : queries) {
+        q = {position(rng), position(rng)};
+    }
+
+    engine::SpatialGrid grid(-1.0f, -1.0f, 1.0f, 1.0f, 0.02f);
+    bench::measure("grid rebuild x100k", ENTITY_COUNT, [&] {
+        grid.clear();
+        for (size_t i = 0; i < points.size(); ++i) {
+            const Point& p = points[i];
+            grid.insert(engine::makeEntityId(static_cast<uint32_t>(i), 0), p.x, p.y, p.x - 0.01f,
+                        p.y - 0.01f, p.x + 0.01f, p.y + 0.01f);
+        }
+        grid.build();
+    });
+
+    bench::measure("grid nearest x1000", QUERY_COUNT, [&] {
+        for (const Point& q : queries) {
+            bench::doNotOptimize(grid.nearest(q.x, q.y));
+        }
+    });
+
+    bench::measure("brute-force nearest x1000", QUERY_COUNT, [&] {
+        for (const Point& q : queries) {
+            size_t best = 0;
+            float bestDistance = 1e9f;
+            for (size_t i = 0; i < points.size(); ++i) {
+                float dx = points[i].x - q.x, dy = points[i].y - q.y;
+                float distance = dx * dx + dy * dy;
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = i;
+                }
+            }
+            bench::doNotOptimize(best);
+        }
+    });
+
+    size_t found = 0;
+    bench::measure("grid range 0.1x0.1 x1000", QUERY_COUNT, [&] {
+        for (const Point& q : queries) {
+            grid.queryRange(q.x - 0.05f, q.y - 0.05f, q.x + 0.05f, q.y + 0.05f,
+                            [&](engine::EntityId) { ++found; });
+        }
+    });
+    bench::doNotOptimize(found);
+}
@@ -0,0 +1,76 @@
+#include "Bench.h"
+#include "engine/ecs/World.h"
+#include "game/components/GameComponents.h"
+#include <vector>
+
+// Per-tick World hashing: incremental state hash against hashing a full
+// snapshot, with a small fraction of entities changing each tick
+namespace {
+
+uint64_t fnv1a(const std::vector<std::byte>& bytes) {
+    uint64_t hash = 14695981039346656037ull;
+    for (std::byte byte : bytes) {
+        hash = (hash ^ static_cast<uint8_t>(byte)) * 1099511628211ull;
+    }
+    return hash;
+}
+
+void runStateHashBench(size_t entityCount, size_t movingEvery) {
+    engine::World world;
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::Velocity>();
+    world.registerComponent<game::Enemy>();
+    world.enableStateHash<game::Transform>();
+    world.enableStateHash<game::Velocity>();
+    world.enableStateHash<game::Enemy>();
+
+    std::vector<engine::EntityId> moving;
+    for (size_t i = 0; i < entityCount; ++i) {
+        engine::EntityId entity = world.createEntity();
+        world.addComponent(entity, game::Transform{float(i), 0.0f, 0.0f});
+        world.addComponent(entity, game::Velocity{0.1f, 0.0f});
+        world.addComponent(entity, game::Enemy{});
+        if (i % movingEvery == 0) {
+            moving.push_back(entity);
+        }
+    }
+    world.getStateHash();
+
+    auto step = [&] {
+        for (engine::EntityId entity : moving) {
+            world.getComponent<game::Transform>(entity).x += 0.1f;
+        }
+    };
+
+    constexpr int TICKS = 100;
+    std::string suffix = " x" + std::to_string(entityCount);
+    bench::measure("incremental getStateHash" + suffix, TICKS, [&] {
+        for (int tick = 0; tick < TICKS; ++tick) {
+            step();
+            bench::doNotOptimize(world.getStateHash());
+        }
+    });
+
+    std::vector<std::byte> snapshot;
+    bench::measure("snapshot + FNV-1a" + suffix, TICKS, [&] {
+        for (int tick = 0; tick < TICKS; ++tick) {
+            step();
+            snapshot.clear();
+            world.saveSnapshot(snapshot);
+            bench::doNotOptimize(fnv1a(snapshot));
+        }
+    });
+
+    bench::measure("movement only (baseline)" + suffix, TICKS, [&] {
+        for (int tick = 0; tick < TICKS; ++tick) {
+            step();
+        }
+    });
+}
+
+} // namespace
+
+BENCH_CASE("StateHash: per-tick hash with 5% of entities changing") {
+    runStateHashBench(10000, 20);
+    runStateHashBench(100000, 20);
+}
@@ -0,0 +1,90 @@
+#include "Bench.h"
+#include "engine/ecs/ArchetypeStorage.h"
+#include "engine/ecs/World.h"
+#include "game/components/GameComponents.h"
+#include <numeric>
+#include <random>
+
+// Sparse pools vs archetype chunks on the MovementSystem access pattern
+// (Transform + Velocity + PreviousTransform). Components are added in a
+// different entity order per type, as happens in a long-running world.
+namespace {
+
+constexpr float DT = 1.0f / 60.0f;
+
+#ifdef ENGINE_ECS_ARCHETYPES
+constexpr const char* WORLD_BACKEND = "world(archetype)";
+#else
+constexpr const char* WORLD_BACKEND = "world(sparse)";
+#endif
+
+inline void integrate(game::Transform& transform, const game::Velocity& velocity,
+                      game::PreviousTransform& prev) {
+    prev.x = transform.x;
+    prev.y = transform.y;
+    prev.rotation = transform.rotation;
+    transform.x += velocity.vx * DT;
+    transform.y += velocity.vy * DT;
+}
+
+std::vector<engine::EntityId> shuffled(size_t count, unsigned seed) {
+    std::vector<engine::EntityId> ids(count);
+    std::iota(ids.begin(), ids.end(), 0);
+    std::shuffle(ids.begin(), ids.end(), std::mt19937(seed));
+    return ids;
+}
+
+void runStorageBench(size_t count) {
+    const std::string suffix = " x" + std::to_string(count);
+
+    engine::World world;
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::Velocity>();
+    world.registerComponent<game::PreviousTransform>();
+    for (size_t i = 0; i < count; ++i) {
+        world.createEntity();
+    }
+    for (engine::EntityId entity : shuffled(count, 1)) {
+        world.addComponent(entity, game::Transform{0.0f, 0.0f, 0.0f});
+    }
+    for (engine::EntityId entity : shuffled(count, 2)) {
+        world.addComponent(entity, game::Velocity{1.0f, 1.0f});
+    }
+    for (engine::EntityId entity : shuffled(count, 3)) {
+        world.addComponent(entity, game::PreviousTransform{0.0f, 0.0f, 0.0f});
+    }
+
+    bench::measure(std::string(WORLD_BACKEND) + " view 3 components" + suffix, count, [&] {
+        world.view<game::Transform, game::Velocity, game::PreviousTransform>().each(
+            [](engine::EntityId, game::Transform& transform, game::Velocity& velocity,
+               game::PreviousTransform& prev) { integrate(transform, velocity, prev); });
+    });
+
+    engine::ArchetypeStorage storage;
+    storage.registerComponent<game::Transform>();
+    storage.registerComponent<game::Velocity>();
+    storage.registerComponent<game::PreviousTransform>();
+    for (engine::EntityId entity : shuffled(count, 1)) {
+        storage.add(entity, game::Transform{0.0f, 0.0f, 0.0f});
+    }
+    for (engine::EntityId entity : shuffled(count, 2)) {
+        storage.add(entity, game::Velocity{1.0f, 1.0f});
+    }
+    for (engine::EntityId entity : shuffled(count, 3)) {
+        storage.add(entity, game::PreviousTransform{0.0f, 0.0f, 0.0f});
+    }
+
+    bench::measure("ArchetypeStorage each 3 components" + suffix, count, [&] {
+        storage.each<game::Transform, game::Velocity, game::PreviousTransform>(
+            [](engine::EntityId, game::Transform& transform, game::Velocity& velocity,
+               game::PreviousTransform& prev) { integrate(transform, velocity, prev); });
+    });
+}
+
+} // namespace
+
+BENCH_CASE("Storage: World view vs archetype chunks") {
+    for (size_t count : {10000u, 100000u, 1000000u}) {
+        runStorageBench(count);
+    }
+}
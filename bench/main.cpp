@@ -0,0 +1,116 @@
+#include "Bench.h"
+#include <cstring>
+#include <ctime>
+#include <string>
+#include <thread>
+
+// engine_bench [filter] [--json FILE] [--list]
+namespace {
+
+void writeJsonString(std::FILE* file, const std::string& text) {
+    std::fputc('"', file);
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            std::fputc('\\', file);
+            std::fputc(c, file);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            std::fprintf(file, "\\u%04x", c);
+        } else {
+            std::fputc(c, file);
+        }
+    }
+    std::fputc('"', file);
+}
+
+// Same layout as Google Benchmark's --benchmark_format=json, so its
+// tools/compare.py can diff two runs. Times are per operation.
+bool writeJson(const std::string& path, const char* executable) {
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+    std::fprintf(file, "{\n  \"context\": {\n    \"date\": \"%s\",\n    \"executable\": ", date);
+    writeJsonString(file, executable);
+    std::fprintf(file, ",\n    \"num_cpus\": %u,\n", std::thread::hardware_concurrency());
+#ifdef NDEBUG
+    std::fprintf(file, "    \"library_build_type\": \"release\",\n");
+#else
+    std::fprintf(file, "    \"library_build_type\": \"debug\",\n");
+#endif
+#ifdef ENGINE_ECS_ARCHETYPES
+    std::fprintf(file, "    \"ecs_backend\": \"archetype\"\n  },\n");
+#else
+    std::fprintf(file, "    \"ecs_backend\": \"sparse\"\n  },\n");
+#endif
+
+    std::fprintf(file, "  \"benchmarks\": [");
+    const std::vector<bench::Result>& results = bench::results();
+    for (size_t i = 0; i < results.size(); ++i) {
+        const bench::Result& result = results[i];
+        std::string name = result.caseName + "/" + result.label;
+        double operations = static_cast<double>(std::max<size_t>(result.operations, 1));
+        double nsPerOp = result.bestNs / operations;
+
+        std::fprintf(file, "%s\n    {\n      \"name\": ", i == 0 ? "" : ",");
+        writeJsonString(file, name);
+        std::fprintf(file, ",\n      \"run_name\": ");
+        writeJsonString(file, name);
+        std::fprintf(file,
+                     ",\n      \"run_type\": \"iteration\",\n"
+                     "      \"repetitions\": %d,\n"
+                     "      \"iterations\": %zu,\n"
+                     "      \"real_time\": %.4f,\n"
+                     "      \"cpu_time\": %.4f,\n"
+                     "      \"time_unit\": \"ns\",\n"
+                     "      \"mean_time\": %.4f,\n"
+                     "      \"items_per_second\": %.6e\n    }",
+                     result.repetitions, result.operations, nsPerOp, nsPerOp,
+                     result.meanNs / operations, nsPerOp > 0.0 ? 1e9 / nsPerOp : 0.0);
+    }
+    std::fprintf(file, "\n  ]\n}\n");
+    bool ok = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && ok;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    const char* filter = nullptr;
+    std::string jsonPath;
+    bool list = false;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--json") == 0 && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else if (std::strcmp(argv[i], "--list") == 0) {
+            list = true;
+        } else if (argv[i][0] != '-' && !filter) {
+            filter = argv[i];
+        } else {
+            std::fprintf(stderr, "usage: %s [filter] [--json FILE] [--list]\n", argv[0]);
+            return 2;
+        }
+    }
+
+    for (const auto& benchCase : bench::registry()) {
+        if (filter && std::strstr(benchCase.name, filter) == nullptr) {
+            continue;
+        }
+        if (list) {
+            std::printf("%s\n", benchCase.name);
+            continue;
+        }
+        std::printf("[%s]\n", benchCase.name);
+        bench::currentCase() = benchCase.name;
+        benchCase.fn();
+    }
+
+    if (!jsonPath.empty() && !list && !writeJson(jsonPath, argv[0])) {
+        std::fprintf(stderr, "Failed to write %s\n", jsonPath.c_str());
+        return 1;
+    }
+    return 0;
+}
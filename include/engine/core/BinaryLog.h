@@ -0,0 +1,213 @@
+#pragma once
+#include "engine/core/Logger.h"
+#include "engine/core/MappedFile.h"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace engine {
+
+// Binary log file layout, all integers little-endian:
+//   header:  "BLOG", u16 version, u16 reserved, u64 capacity, u64 end of the
+//            records and u64 records dropped (both 0 until the log is
+//            closed), i64 wall-clock ns at open
+//   records: u32 size (whole record), u16 format id, u16 reserved,
+//            u64 ns since open, then the raw argument bytes. Strings are a
+//            u16 length followed by their bytes.
+// Format id 0 defines a log site instead: u16 id, u8 level, u8 reserved,
+// u32 line, then file, format and argument types as u16-length strings.
+// A site is defined in the file before its first record. A log that was not
+// closed is read up to the first zero size.
+constexpr uint32_t BINARY_LOG_MAGIC = 0x474F4C42; // "BLOG"
+constexpr uint16_t BINARY_LOG_VERSION = 1;
+constexpr size_t BINARY_LOG_HEADER_SIZE = 40;
+constexpr size_t BINARY_LOG_RECORD_HEADER_SIZE = 16;
+
+// One character per argument, as in Python's struct module
+template<typename T>
+constexpr char binaryLogTypeCode() {
+    if constexpr (std::is_enum_v<T>) {
+        return binaryLogTypeCode<std::underlying_type_t<T>>();
+    } else if constexpr (std::is_same_v<T, bool>) {
+        return '?';
+    } else if constexpr (std::is_same_v<T, char>) {
+        return 'c';
+    } else if constexpr (std::is_integral_v<T>) {
+        constexpr bool isSigned = std::is_signed_v<T>;
+        switch (sizeof(T)) {
+            case 1: return isSigned ? 'b' : 'B';
+            case 2: return isSigned ? 'h' : 'H';
+            case 4: return isSigned ? 'i' : 'I';
+            default: return isSigned ? 'q' : 'Q';
+        }
+    } else if constexpr (std::is_same_v<T, float>) {
+        return 'f';
+    } else if constexpr (std::is_same_v<T, double>) {
+        return 'd';
+    } else {
+        static_assert(std::is_convertible_v<T, std::string_view>,
+                      "Binary log arguments must be numbers, enums or strings.");
+        return 's';
+    }
+}
+
+// High-volume telemetry: each log site registers its format once and then
+// writes only its raw arguments into a memory-mapped file. Text is produced
+// offline by BinaryLogReader (see the binlog_decode tool). Log through
+// ENGINE_BINARY_LOG; the writer is lock-free and safe to use from any thread.
+class BinaryLog {
+public:
+    // Creates `path` with room for `capacity` bytes of records. Records that
+    // don't fit are dropped and counted. Call before other threads log.
+    static bool Open(const std::string& path, size_t capacity = 64u << 20);
+    // Trims the file to the records written. Call once other threads stop.
+    static void Close();
+    static bool IsOpen() { return openFlag.load(std::memory_order_acquire); }
+    static uint64_t GetDroppedCount();
+
+    // Returns the id of a new log site. Used by ENGINE_BINARY_LOG.
+    static uint16_t RegisterSite(LogLevel level, const char* file, uint32_t line,
+                                 const char* format, const char* types);
+
+    template<typename... Args>
+    static void Write(uint16_t siteId, const Args&... args) {
+        if (siteId != 0) {
+            WriteRecord(siteId, args...);
+        }
+    }
+
+private:
+    // Site 0 holds site definitions
+    template<typename... Args>
+    static void WriteRecord(uint16_t siteId, const Args&... args) {
+        size_t size = BINARY_LOG_RECORD_HEADER_SIZE + (0 + ... + ArgSize(args));
+        std::byte* record = Reserve(size);
+        if (!record) {
+            return;
+        }
+        std::byte* cursor = record + sizeof(uint32_t);
+        uint16_t reserved = 0;
+        uint64_t timestamp = Timestamp();
+        cursor = Put(cursor, &siteId, sizeof(siteId));
+        cursor = Put(cursor, &reserved, sizeof(reserved));
+        cursor = Put(cursor, &timestamp, sizeof(timestamp));
+        ((cursor = PutArg(cursor, args)), ...);
+        Commit(record, size);
+    }
+
+    template<typename T>
+    static size_t ArgSize(const T& value) {
+        if constexpr (binaryLogTypeCode<std::decay_t<T>>() == 's') {
+            return sizeof(uint16_t) + StringArg(value).size();
+        } else {
+            return sizeof(T);
+        }
+    }
+
+    template<typename T>
+    static std::byte* PutArg(std::byte* cursor, const T& value) {
+        if constexpr (binaryLogTypeCode<std::decay_t<T>>() == 's') {
+            std::string_view text = StringArg(value);
+            uint16_t length = static_cast<uint16_t>(text.size());
+            cursor = Put(cursor, &length, sizeof(length));
+            return Put(cursor, text.data(), length);
+        } else {
+            return Put(cursor, &value, sizeof(T));
+        }
+    }
+
+    template<typename T>
+    static std::string_view StringArg(const T& value) {
+        std::string_view text(value);
+        return text.substr(0, UINT16_MAX);
+    }
+
+    static std::byte* Put(std::byte* cursor, const void* data, size_t size) {
+        std::memcpy(cursor, data, size);
+        return cursor + size;
+    }
+
+    // Space for one record in the mapping, or nullptr if the log is full
+    static std::byte* Reserve(size_t size);
+    // Publishes the record by writing its size last
+    static void Commit(std::byte* record, size_t size);
+    static uint64_t Timestamp();
+
+    static inline std::atomic<bool> openFlag{false};
+};
+
+// Logs `format` with "{}" placeholders filled from the arguments:
+//   ENGINE_BINARY_LOG(LogLevel::INFO, "spawned {} at {}, {}", entity, x, y);
+// The arguments are evaluated once, like a function call's, but only copied
+// while a binary log is open and `level` passes Logger::IsEnabled(). Levels
+// below ENGINE_LOG_MIN_LEVEL compile to nothing. `level` must be a constant.
+#define ENGINE_BINARY_LOG(level, ...)                                                       \
+    [](const char* engineFormat, const auto&... engineArgs) {                               \
+        if constexpr ((level) >= ::engine::COMPILED_LOG_LEVEL) {                            \
+            if (!::engine::BinaryLog::IsOpen() || !::engine::Logger::IsEnabled(level)) {    \
+                return;                                                                     \
+            }                                                                               \
+            static constexpr char engineTypes[] = {                                         \
+                ::engine::binaryLogTypeCode<std::decay_t<decltype(engineArgs)>>()..., '\0'}; \
+            static const uint16_t engineSite = ::engine::BinaryLog::RegisterSite(           \
+                level, __FILE__, __LINE__, engineFormat, engineTypes);                      \
+            ::engine::BinaryLog::Write(engineSite, engineArgs...);                          \
+        } else {                                                                            \
+            (void)engineFormat;                                                             \
+            ((void)engineArgs, ...);                                                        \
+        }                                                                                   \
+    }(__VA_ARGS__)
+
+// One decoded record
+struct BinaryLogEvent {
+    int64_t timestampNs = 0; // Wall clock, as for Logger output
+    LogLevel level = LogLevel::INFO;
+    std::string text;
+    std::string_view file;
+    uint32_t line = 0;
+};
+
+// Reads a binary log back into text, record by record
+class BinaryLogReader {
+public:
+    // False if the file is missing or not a binary log
+    bool Open(const std::string& path);
+    // Decodes the next record. False at the end of the log or at a record
+    // that is corrupt (see IsCorrupt()).
+    bool Next(BinaryLogEvent& event);
+
+    bool IsCorrupt() const { return corrupt; }
+    // False if the writer never closed the log, e.g. after a crash
+    bool WasClosed() const { return closed; }
+    // Records the writer had no room for
+    uint64_t GetDroppedCount() const { return dropped; }
+
+private:
+    struct Site {
+        LogLevel level = LogLevel::INFO;
+        uint32_t line = 0;
+        std::string_view file;
+        std::string_view format;
+        std::string_view types;
+        bool defined = false;
+    };
+
+    bool ReadSite(const std::byte* payload, size_t size);
+    bool Format(const Site& site, const std::byte* payload, size_t size, std::string& text);
+
+    MappedFile file;
+    std::vector<Site> sites;
+    size_t position = 0;
+    size_t end = 0;
+    int64_t startNs = 0;
+    uint64_t dropped = 0;
+    bool closed = false;
+    bool corrupt = false;
+};
+
+} // namespace engine
@@ -1,4 +1,7 @@
 #pragma once
+#ifdef HEADLESS_SERVER
+#error "Engine needs GLFW and OpenGL; headless builds use engine/core/Simulation.h"
+#endif
 #include <GLFW/glfw3.h>
 #include <string>
 #include <vector>
@@ -7,8 +10,14 @@
 #include "engine/platform/Renderer.h"
 #include "engine/ecs/World.h"
 #include "engine/ecs/System.h"
+#include "engine/core/Simulation.h"
 #include "game/components/GameComponents.h"
 
+namespace engine {
+class InputSystem;
+class RenderSystem;
+}
+
 class Engine {
 public:
     Engine(int width, int height, const std::string& title);
@@ -27,6 +36,7 @@ private:
     void Cleanup();
     void Update(float dt);
     void Render(float alpha);
+    void HandleProfilerKeys();
     int width, height;
     std::string title;
     Renderer renderer;
@@ -41,9 +51,20 @@ private:
     int frameCount = 0;
     float fpsTimer = 0.0f;
 
-    // ECS World
-    engine::World world;
+    // GL-free game state: ECS world plus the systems run each fixed step
+    engine::Simulation simulation;
+    engine::World& world = simulation.getWorld();
+
+    // F3 starts profiling (stats logged every second plus a trace), F4
+    // writes the trace to trace.json and stops
+    engine::Profiler& profiler = simulation.getProfiler();
+    uint32_t fixedStepSection = profiler.addSection("FixedStep");
+    uint32_t renderSection = profiler.addSection("Render");
+    uint32_t swapSection = profiler.addSection("SwapBuffers");
     
-    // ECS Systems
-    std::vector<std::unique_ptr<engine::System>> systems;
+    // Owned by the simulation; keyframes are captured between ticks
+    engine::InputSystem* inputSystem = nullptr;
+
+    // Runs once per frame, outside the fixed step
+    std::unique_ptr<engine::RenderSystem> renderSystem;
 };
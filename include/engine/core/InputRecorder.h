@@ -1,10 +1,48 @@
 #pragma once
-#include <vector>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
 #include <string>
+#include <vector>
+#include "engine/core/MappedFile.h"
+#include "engine/ecs/Entity.h"
 #include "game/components/GameComponents.h"
 
 namespace engine {
 
+// Replay file layout, all integers little-endian:
+//   header: "INPR", u16 version, u16 tick rate, u32 entity, u64 frame count
+//   body:   one record per run of identical frames. The low six bits of the
+//           record byte are the PlayerInput flags; bit 7 means a LEB128
+//           varint follows holding the run length minus two. A lone 0x40
+//           byte starts a keyframe instead: u32 size, then a World snapshot
+//           taken before the frame that follows it.
+//   footer: u32 index interval, u64 entry count, then per interval frames
+//           {u64 record offset, u64 frames of that run to skip}; u64
+//           keyframe count, then {u64 frame, u64 offset, u64 size} each
+//   trailer: u64 footer offset, "INPX"
+// The footer and frame count are written when recording stops. A recording
+// that was cut short keeps a count of 0 and can only be played from the
+// start, until its data runs out.
+constexpr uint32_t INPUT_RECORDING_MAGIC = 0x52504E49; // "INPR"
+constexpr uint32_t INPUT_RECORDING_FOOTER_MAGIC = 0x58504E49; // "INPX"
+constexpr uint16_t INPUT_RECORDING_VERSION = 3;
+constexpr size_t INPUT_RECORDING_HEADER_SIZE = 20;
+constexpr size_t INPUT_RECORDING_BLOCK_SIZE = 4096;
+constexpr uint32_t INPUT_RECORDING_INDEX_INTERVAL = 256;
+
+// World snapshot stored in a recording, pointing into the mapped file
+struct InputKeyframe {
+    uint64_t frame = 0;
+    const std::byte* data = nullptr;
+    size_t size = 0;
+};
+
+// Records PlayerInput to a file as it happens and plays it back again.
+// Recording streams through a single fixed-size block, so memory use does not
+// grow with the length of the session. Playback maps the file and reads it in
+// place; with a footer it can jump to any frame.
 class InputRecorder {
 public:
     enum class State {
@@ -14,23 +52,92 @@ public:
     };
 
     InputRecorder();
+    ~InputRecorder();
+
+    InputRecorder(const InputRecorder&) = delete;
+    InputRecorder& operator=(const InputRecorder&) = delete;
 
-    void StartRecording();
-    void StopRecording(const std::string& filename);
+    // `entity` is the entity whose input is recorded; INVALID_ENTITY
+    // records whatever ProcessInput() is given
+    void StartRecording(const std::string& filename, uint16_t tickRate = 60,
+                        EntityId entity = INVALID_ENTITY);
+    void StopRecording();
     void StartPlayback(const std::string& filename);
     void StopPlayback();
 
     // Returns true if we are in playback mode and overwrote the input
     bool ProcessInput(game::PlayerInput& input);
 
+    // Stores a World snapshot taken before the next recorded frame
+    void AddKeyframe(const std::vector<std::byte>& snapshot);
+
+    // Makes `frame` the next frame played back, in constant time. False if
+    // the recording has no index or is shorter than that.
+    bool SeekToFrame(uint64_t frame);
+    // Latest keyframe at or before `frame`. False if there is none.
+    bool FindKeyframe(uint64_t frame, InputKeyframe& keyframe) const;
+    uint64_t GetKeyframeCount() const { return keyframeCount; }
+    bool CanSeek() const { return indexOffset != 0 && frameCount != 0; }
+
     State GetState() const { return state; }
-    size_t GetFrameCount() const { return frames.size(); }
-    size_t GetCurrentFrame() const { return currentFrame; }
+    // Frames recorded so far, or the length of the recording being played
+    // back (0 if it was cut short)
+    uint64_t GetFrameCount() const { return frameCount; }
+    uint64_t GetCurrentFrame() const { return currentFrame; }
+    uint16_t GetTickRate() const { return tickRate; }
+    EntityId GetEntity() const { return entity; }
+
+    static uint8_t PackInput(const game::PlayerInput& input);
+    static game::PlayerInput UnpackInput(uint8_t bits);
 
 private:
+    struct IndexEntry {
+        uint64_t offset;
+        uint64_t skip;
+    };
+    struct KeyframeEntry {
+        uint64_t frame;
+        uint64_t offset;
+        uint64_t size;
+    };
+
+    void WriteRun();
+    void WriteByte(uint8_t value);
+    void WriteBytes(const uint8_t* data, size_t size);
+    void FlushBlock();
+    void WriteFooter();
+    bool ReadFooter();
+    bool ReadByte(uint8_t& value);
+    bool ReadRun();
+    bool SkipFrames(uint64_t count);
+
     State state;
-    std::vector<game::PlayerInput> frames;
-    size_t currentFrame;
+    std::string filename;
+    uint16_t tickRate;
+    EntityId entity;
+    uint64_t frameCount;
+    uint64_t currentFrame;
+
+    // Run being recorded or played back
+    uint8_t runInput;
+    uint64_t runLength;
+
+    // Recording
+    std::ofstream outFile;
+    std::array<uint8_t, INPUT_RECORDING_BLOCK_SIZE> block;
+    size_t blockPosition;
+    uint64_t fileOffset; // Bytes written so far, including the block
+    std::vector<IndexEntry> index;
+    std::vector<KeyframeEntry> keyframes;
+
+    // Playback
+    MappedFile mappedFile;
+    size_t readPosition;
+    size_t bodyEnd;
+    size_t indexOffset;    // Of the first index entry, 0 without a footer
+    uint64_t indexCount;
+    size_t keyframeOffset; // Of the first keyframe entry
+    uint64_t keyframeCount;
 };
 
 } // namespace engine
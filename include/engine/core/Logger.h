@@ -1,9 +1,20 @@
 #pragma once
 
-#include <string>
-#include <mutex>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
 #include <sstream>
-#include <iostream>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+// Calls below this level compile to nothing. Their arguments are still
+// evaluated, but never formatted. 0 = DEBUG ... 3 = ERROR.
+#ifndef ENGINE_LOG_MIN_LEVEL
+#define ENGINE_LOG_MIN_LEVEL 0
+#endif
 
 namespace engine {
 
@@ -14,50 +25,164 @@ enum class LogLevel {
     ERROR
 };
 
+constexpr LogLevel COMPILED_LOG_LEVEL = static_cast<LogLevel>(ENGINE_LOG_MIN_LEVEL);
+
+// What async logging does when the queue is full
+enum class LogOverflow {
+    DROP,  // Discard the record and count it; the caller never waits
+    BLOCK  // Wait for the writer thread to make room
+};
+
+struct LoggerConfig {
+    LogLevel level = LogLevel::DEBUG; // Runtime threshold, see Logger::SetLevel()
+
+    // Records go through a queue to a writer thread instead of being
+    // written by the caller
+    bool async = false;
+    size_t queueCapacity = 8192; // Records; rounded up to a power of two
+    LogOverflow overflow = LogOverflow::DROP;
+
+    bool console = true;  // stdout
+    bool colors = true;   // ANSI colours on the console
+    std::string filePath; // Also append to this file if set
+};
+
+// Message text built on the stack. Only messages longer than the inline
+// buffer move to the heap.
+class LogMessage {
+public:
+    LogMessage() = default;
+    LogMessage(const LogMessage&) = delete;
+    LogMessage& operator=(const LogMessage&) = delete;
+
+    void append(const char* data, size_t size) {
+        if (!spilled && length + size <= INLINE_CAPACITY) {
+            std::memcpy(buffer + length, data, size);
+            length += size;
+            return;
+        }
+        if (!spilled) {
+            heap.assign(buffer, length);
+            spilled = true;
+        }
+        heap.append(data, size);
+    }
+    void append(std::string_view text) { append(text.data(), text.size()); }
+    void append(char c) { append(&c, 1); }
+
+    std::string_view view() const {
+        return spilled ? std::string_view(heap) : std::string_view(buffer, length);
+    }
+
+private:
+    static constexpr size_t INLINE_CAPACITY = 256;
+
+    char buffer[INLINE_CAPACITY];
+    size_t length = 0;
+    bool spilled = false;
+    std::string heap;
+};
+
 class Logger {
 public:
-    static void Init();
-    static void Log(LogLevel level, const std::string& message);
-    
+    // Replaces the current configuration, draining queued records first.
+    // Safe while other threads log: calls made during the switch are written
+    // directly, each with either the old or the new configuration.
+    static void Init(const LoggerConfig& config = LoggerConfig());
+    // Drains the queue, stops the writer thread and returns to the default
+    // synchronous console output
+    static void Shutdown();
+    // Blocks until every record logged so far has been written
+    static void Flush();
+    // Records discarded by LogOverflow::DROP since Init()
+    static uint64_t GetDroppedCount();
+
+    // Messages below `level` are discarded before their arguments are
+    // formatted. Safe to change while other threads log.
+    static void SetLevel(LogLevel level) { runtimeLevel.store(level, std::memory_order_relaxed); }
+    static LogLevel GetLevel() { return runtimeLevel.load(std::memory_order_relaxed); }
+    static bool IsEnabled(LogLevel level) {
+        return level >= COMPILED_LOG_LEVEL && level >= runtimeLevel.load(std::memory_order_relaxed);
+    }
+
+    static void Log(LogLevel level, std::string_view message);
+
     template<typename... Args>
-    static void Debug(Args... args) {
-        Log(LogLevel::DEBUG, Format(args...));
+    static void Debug(Args&&... args) {
+        Write<LogLevel::DEBUG>(std::forward<Args>(args)...);
     }
 
     template<typename... Args>
-    static void Info(Args... args) {
-        Log(LogLevel::INFO, Format(args...));
+    static void Info(Args&&... args) {
+        Write<LogLevel::INFO>(std::forward<Args>(args)...);
     }
 
     template<typename... Args>
-    static void Warn(Args... args) {
-        Log(LogLevel::WARN, Format(args...));
+    static void Warn(Args&&... args) {
+        Write<LogLevel::WARN>(std::forward<Args>(args)...);
     }
 
     template<typename... Args>
-    static void Error(Args... args) {
-        Log(LogLevel::ERROR, Format(args...));
+    static void Error(Args&&... args) {
+        Write<LogLevel::ERROR>(std::forward<Args>(args)...);
     }
 
-private:
-    static std::mutex logMutex;
-    
-    // Base case for recursion
-    static void FormatHelper(std::stringstream&) {}
+    // Appends the arguments as operator<< would print them. Numbers and
+    // strings are formatted without streams or allocations; other types
+    // fall back to a std::ostringstream.
+    template<typename... Args>
+    static void FormatTo(LogMessage& message, const Args&... args) {
+        (AppendArg(message, args), ...);
+    }
 
-    // Recursive variadic template to stream arguments
-    template<typename T, typename... Args>
-    static void FormatHelper(std::stringstream& ss, T first, Args... args) {
-        ss << first;
-        FormatHelper(ss, args...);
+private:
+    template<LogLevel LEVEL, typename... Args>
+    static void Write(Args&&... args) {
+        if constexpr (LEVEL >= COMPILED_LOG_LEVEL) {
+            if (IsEnabled(LEVEL)) {
+                LogMessage message;
+                FormatTo(message, args...);
+                Log(LEVEL, message.view());
+            }
+        } else {
+            ((void)args, ...);
+        }
     }
 
-    template<typename... Args>
-    static std::string Format(Args... args) {
-        std::stringstream ss;
-        FormatHelper(ss, args...);
-        return ss.str();
+    template<typename T>
+    static void AppendArg(LogMessage& message, const T& value) {
+        using Type = std::decay_t<T>;
+        if constexpr (std::is_same_v<Type, char> || std::is_same_v<Type, signed char> ||
+                      std::is_same_v<Type, unsigned char>) {
+            message.append(static_cast<char>(value));
+        } else if constexpr (std::is_same_v<Type, bool>) {
+            message.append(value ? '1' : '0');
+        } else if constexpr (std::is_integral_v<Type> && std::is_signed_v<Type>) {
+            AppendSigned(message, static_cast<long long>(value));
+        } else if constexpr (std::is_integral_v<Type>) {
+            AppendUnsigned(message, static_cast<unsigned long long>(value));
+        } else if constexpr (std::is_floating_point_v<Type>) {
+            AppendFloat(message, static_cast<double>(value));
+        } else if constexpr (std::is_same_v<Type, const char*> || std::is_same_v<Type, char*>) {
+            const char* text = value;
+            message.append(text ? std::string_view(text) : std::string_view("(null)"));
+        } else if constexpr (std::is_convertible_v<const T&, std::string_view>) {
+            message.append(std::string_view(value));
+        } else if constexpr (std::is_pointer_v<Type>) {
+            AppendPointer(message, static_cast<const void*>(value));
+        } else {
+            std::ostringstream stream;
+            stream << value;
+            message.append(stream.str());
+        }
     }
+
+    static void AppendSigned(LogMessage& message, long long value);
+    static void AppendUnsigned(LogMessage& message, unsigned long long value);
+    static void AppendFloat(LogMessage& message, double value);
+    static void AppendPointer(LogMessage& message, const void* value);
+
+    static inline std::atomic<LogLevel> runtimeLevel{LogLevel::DEBUG};
 };
 
 } // namespace engine
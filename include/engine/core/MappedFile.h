@@ -0,0 +1,36 @@
+#pragma once
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace engine {
+
+// Read-only view of a whole file. POSIX builds map it with mmap so opening is
+// instant and pages are loaded on first touch; elsewhere the file is read
+// into memory up front.
+class MappedFile {
+public:
+    MappedFile() = default;
+    ~MappedFile();
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    // Replaces any previously opened file. False if it can't be opened.
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return opened; }
+    const std::byte* data() const { return bytes; }
+    size_t size() const { return length; }
+
+private:
+    const std::byte* bytes = nullptr;
+    size_t length = 0;
+    bool opened = false;
+#ifdef _WIN32
+    std::vector<std::byte> buffer;
+#endif
+};
+
+} // namespace engine
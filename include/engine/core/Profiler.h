@@ -0,0 +1,113 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace engine {
+
+// Timings of one section since the previous Profiler::collect()
+struct ProfileStats {
+    std::string name;
+    uint32_t count = 0;
+    double minMs = 0.0;
+    double avgMs = 0.0;
+    double p99Ms = 0.0;
+    double maxMs = 0.0;
+};
+
+// Collects scoped timings of named sections (systems, the fixed step,
+// rendering) from any thread. collect() turns them into per-section stats,
+// e.g. once a second. While tracing, every timing is also kept as an event
+// for a Chrome trace (chrome://tracing or ui.perfetto.dev). A disabled
+// profiler costs one relaxed load per scope.
+class Profiler {
+public:
+    // Samples kept per section between collect() calls. Beyond this they are
+    // reservoir-sampled: count, min, avg and max stay exact, p99 is estimated.
+    static constexpr size_t MAX_SAMPLES = 16384;
+
+    Profiler();
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    void setEnabled(bool enabled) { enabledFlag.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabledFlag.load(std::memory_order_relaxed); }
+
+    // Id of the section called `name`, created on first use
+    uint32_t addSection(const std::string& name);
+
+    // Time since the profiler was created, in nanoseconds
+    int64_t now() const {
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                   std::chrono::steady_clock::now() - origin)
+            .count();
+    }
+    void record(uint32_t section, int64_t startNs, int64_t endNs);
+
+    // Stats of every section timed since the last call, then starts over.
+    // Sections without timings are left out.
+    std::vector<ProfileStats> collect();
+    // collect(), logged as one line per section
+    void logStats();
+
+    // Trace events are kept from startTrace() until writeTrace(), up to
+    // `maxEvents`; later ones are dropped
+    void startTrace(size_t maxEvents = 1000000);
+    bool isTracing() const;
+    // Writes the events as trace_event JSON and stops tracing
+    bool writeTrace(const std::string& path);
+
+private:
+    struct Section {
+        std::string name;
+        std::vector<int64_t> samples; // Durations in ns, at most MAX_SAMPLES
+        uint64_t count = 0;           // Samples recorded, kept or not
+        int64_t totalNs = 0;
+        int64_t minNs = 0;
+        int64_t maxNs = 0;
+    };
+    struct TraceEvent {
+        uint32_t section;
+        uint32_t thread;
+        int64_t startNs;
+        int64_t durationNs;
+    };
+
+    std::chrono::steady_clock::time_point origin;
+    std::atomic<bool> enabledFlag{false};
+
+    mutable std::mutex mutex;
+    std::vector<Section> sections;
+    std::vector<TraceEvent> trace;
+    size_t traceLimit = 0; // 0 while not tracing
+    size_t droppedEvents = 0;
+    uint64_t reservoirState = 0x9E3779B97F4A7C15ull; // Picks which samples to keep
+};
+
+// Times the enclosing scope as one sample of a section
+class ProfileScope {
+public:
+    ProfileScope(Profiler* profiler, uint32_t section)
+        : profiler(profiler && profiler->isEnabled() ? profiler : nullptr), section(section),
+          startNs(this->profiler ? this->profiler->now() : 0) {}
+    ~ProfileScope() {
+        if (profiler) {
+            profiler->record(section, startNs, profiler->now());
+        }
+    }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    Profiler* profiler;
+    uint32_t section;
+    int64_t startNs;
+};
+
+} // namespace engine
@@ -0,0 +1,57 @@
+#pragma once
+#include "engine/core/Profiler.h"
+#include "engine/core/ThreadPool.h"
+#include "engine/ecs/Scheduler.h"
+#include "engine/ecs/SpatialGrid.h"
+#include "engine/ecs/World.h"
+#include <cstdint>
+#include <memory>
+
+namespace engine {
+
+// Everything needed to advance the game without a window: the ECS world with
+// the game components registered, the system scheduler and its thread pool,
+// the spatial index and a profiler timing each tick and system (disabled until
+// getProfiler().setEnabled(true)). Shared by the windowed client and the
+// headless server.
+class Simulation {
+public:
+    explicit Simulation(size_t workerCount = ThreadPool::defaultWorkerCount());
+
+    Simulation(const Simulation&) = delete;
+    Simulation& operator=(const Simulation&) = delete;
+
+    // Systems run in registration order where their accesses conflict
+    System& addSystem(std::unique_ptr<System> system) {
+        return scheduler.addSystem(std::move(system));
+    }
+
+    // Advances one fixed step
+    void update(float dt) {
+        ProfileScope scope(&profiler, tickSection);
+        scheduler.update(world, dt);
+        ++tickCount;
+    }
+
+    // Makes every game component part of getWorld().getStateHash()
+    void enableStateHash();
+
+    World& getWorld() { return world; }
+    ThreadPool& getThreadPool() { return threadPool; }
+    Profiler& getProfiler() { return profiler; }
+    SpatialGrid& getSpatialGrid() { return spatialGrid; }
+    uint64_t getTickCount() const { return tickCount; }
+
+private:
+    World world;
+    ThreadPool threadPool;
+    Profiler profiler;
+    uint32_t tickSection = profiler.addSection("Tick");
+    Scheduler scheduler{threadPool, &profiler};
+
+    // Entity positions, rebuilt by MovementSystem and used for render culling
+    SpatialGrid spatialGrid{-1.0f, -1.0f, 1.0f, 1.0f, 0.1f};
+    uint64_t tickCount = 0;
+};
+
+} // namespace engine
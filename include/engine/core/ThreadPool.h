@@ -0,0 +1,91 @@
+#pragma once
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace engine {
+
+// Completion counter for a batch of tasks submitted to a ThreadPool
+class TaskGroup {
+public:
+    bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class ThreadPool;
+    std::atomic<size_t> pending{0};
+};
+
+// Work-stealing thread pool. Every worker owns a task deque: it pops its own
+// newest task first and steals the oldest task of another queue when idle.
+// Threads waiting on a TaskGroup help run tasks, so nested parallel work
+// cannot deadlock and a pool with zero workers runs everything on the caller.
+class ThreadPool {
+public:
+    // Defaults to one worker per hardware thread, minus the calling thread
+    explicit ThreadPool(size_t workerCount = defaultWorkerCount());
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    void submit(TaskGroup& group, std::function<void()> task);
+
+    // Blocks until every task of the group has finished
+    void wait(TaskGroup& group);
+
+    // Splits [0, count) into grainSize ranges and calls func(begin, end) for
+    // each, in parallel. The caller runs the first range itself. func must not
+    // depend on the order ranges run in.
+    template<typename Func>
+    void parallelFor(size_t count, size_t grainSize, Func&& func) {
+        grainSize = std::max<size_t>(grainSize, 1);
+        if (count <= grainSize || workers.empty()) {
+            if (count > 0) {
+                func(size_t(0), count);
+            }
+            return;
+        }
+
+        TaskGroup group;
+        for (size_t begin = grainSize; begin < count; begin += grainSize) {
+            size_t end = std::min(begin + grainSize, count);
+            submit(group, [&func, begin, end] { func(begin, end); });
+        }
+        func(size_t(0), grainSize);
+        wait(group);
+    }
+
+    size_t getWorkerCount() const { return workers.size(); }
+
+    static size_t defaultWorkerCount();
+
+private:
+    struct TaskQueue {
+        std::mutex mutex;
+        std::deque<std::function<void()>> tasks;
+    };
+
+    void workerLoop(size_t index);
+    bool tryRunTask(size_t preferredQueue);
+    bool tryPop(size_t queueIndex, bool newest, std::function<void()>& task);
+
+    // queues[0] takes submissions from outside the pool, queues[i + 1] belongs to worker i
+    std::vector<std::unique_ptr<TaskQueue>> queues;
+    std::vector<std::thread> workers;
+
+    std::mutex sleepMutex;
+    std::condition_variable taskAvailable;
+    std::condition_variable groupDone;
+    std::atomic<size_t> queuedTasks{0};
+    std::atomic<size_t> nextQueue{0};
+    bool stopping = false;
+};
+
+} // namespace engine
@@ -0,0 +1,336 @@
+#pragma once
+#include "Entity.h"
+#include "Component.h"
+#include "ChangeTracking.h"
+#include "engine/core/ThreadPool.h"
+#include <array>
+#include <cassert>
+#include <cstddef>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <unordered_map>
+#include <vector>
+
+namespace engine {
+
+// Bytes per archetype chunk
+constexpr size_t ARCHETYPE_CHUNK_SIZE = 16 * 1024;
+
+// Fixed-size block holding up to Archetype::chunkCapacity rows, laid out
+// column by column (SoA): [entity IDs][component A][component B]...
+struct ArchetypeChunk {
+    std::unique_ptr<std::byte[]> memory;
+    uint32_t count = 0;
+};
+
+// All entities sharing one exact signature. Every chunk uses the same
+// column layout, and all chunks but the last are always full.
+struct Archetype {
+    Signature signature;
+    std::vector<ComponentTypeId> types;                  // Component types, ascending
+    std::array<uint32_t, MAX_COMPONENTS> columnOffsets{}; // Byte offset of each column
+    uint32_t chunkCapacity = 0;                          // Rows per chunk
+    size_t chunkBytes = 0;
+    std::vector<ArchetypeChunk> chunks;
+    uint32_t entityCount = 0;
+
+    EntityId* entities(ArchetypeChunk& chunk) const {
+        return reinterpret_cast<EntityId*>(chunk.memory.get());
+    }
+
+    template<typename T>
+    T* column(ArchetypeChunk& chunk) const {
+        return reinterpret_cast<T*>(chunk.memory.get() + columnOffsets[getComponentTypeId<T>()]);
+    }
+};
+
+// Archetype/chunk component storage: entities with an identical signature
+// share SoA chunks, so multi-component queries stream over contiguous memory.
+// Adding or removing a component moves the entity to another archetype.
+// Components must be trivially copyable since rows are moved with memcpy.
+class ArchetypeStorage {
+public:
+    template<typename T>
+    void registerComponent() {
+        static_assert(std::is_trivially_copyable_v<T>,
+                      "Archetype storage requires trivially copyable components.");
+        static_assert(alignof(T) <= alignof(std::max_align_t), "Over-aligned component type.");
+
+        // Tags only contribute a signature bit and take no column space
+        ComponentTypeId typeId = getComponentTypeId<T>();
+        assert(typeId < MAX_COMPONENTS && "Too many component types.");
+        componentInfo[typeId] = {std::is_empty_v<T> ? 0u : static_cast<uint32_t>(sizeof(T)),
+                                 static_cast<uint32_t>(alignof(T)), true};
+    }
+
+    template<typename T>
+    void add(EntityId entity, const T& component) {
+        ComponentTypeId typeId = getComponentTypeId<T>();
+        assert(componentInfo[typeId].registered && "Component not registered before use.");
+        assert(!has<T>(entity) && "Component added to same entity more than once.");
+
+        Signature signature = getSignature(entity);
+        signature.set(typeId);
+        moveEntity(entity, signature);
+        if constexpr (!std::is_empty_v<T>) {
+            std::memcpy(componentData(entity, typeId), &component, sizeof(T));
+        }
+    }
+
+    template<typename T>
+    void remove(EntityId entity) {
+        assert(has<T>(entity) && "Removing non-existent component.");
+
+        Signature signature = getSignature(entity);
+        signature.reset(getComponentTypeId<T>());
+        moveEntity(entity, signature);
+    }
+
+    template<typename T>
+    T& get(EntityId entity) {
+        assert(has<T>(entity) && "Retrieving non-existent component.");
+        if constexpr (std::is_empty_v<T>) {
+            return tagComponent<T>();
+        } else {
+            return *reinterpret_cast<T*>(componentData(entity, getComponentTypeId<T>()));
+        }
+    }
+
+    template<typename T>
+    bool has(EntityId entity) const {
+        const EntityLocation* location = find(entity);
+        return location && archetypes[location->archetype]->signature.test(getComponentTypeId<T>());
+    }
+
+    // Drops all components of an entity
+    void destroy(EntityId entity);
+
+    // Calls func(EntityId, Ts&...) for every entity whose archetype contains Ts...
+    // Chunks are walked back to front, so destroying the current entity inside
+    // func is safe; other structural changes during iteration are not.
+    template<typename... Ts, typename Func>
+    void each(Func&& func) {
+        Signature required;
+        (required.set(getComponentTypeId<Ts>()), ...);
+
+        for (size_t a = 0; a < archetypes.size(); ++a) {
+            Archetype& archetype = *archetypes[a];
+            if ((archetype.signature & required) != required) {
+                continue;
+            }
+            for (size_t c = archetype.chunks.size(); c-- > 0;) {
+                ArchetypeChunk& chunk = archetype.chunks[c];
+                EntityId* entities = archetype.entities(chunk);
+                std::tuple<Ts*...> columns{archetype.template column<Ts>(chunk)...};
+                for (uint32_t row = chunk.count; row-- > 0;) {
+                    if (row >= chunk.count) {
+                        continue;
+                    }
+                    func(entities[row], rowRef<Ts>(std::get<Ts*>(columns), row)...);
+                }
+            }
+        }
+    }
+
+    // Parallel each(): every non-empty matching chunk is one work item.
+    // func may only write the components it is handed.
+    template<typename... Ts, typename Func>
+    void parallelEach(ThreadPool& threadPool, Func&& func) {
+        Signature required;
+        (required.set(getComponentTypeId<Ts>()), ...);
+
+        std::vector<std::pair<Archetype*, ArchetypeChunk*>> work;
+        for (auto& archetype : archetypes) {
+            if ((archetype->signature & required) != required) {
+                continue;
+            }
+            for (auto& chunk : archetype->chunks) {
+                if (chunk.count > 0) {
+                    work.emplace_back(archetype.get(), &chunk);
+                }
+            }
+        }
+
+        threadPool.parallelFor(work.size(), 1, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                auto [archetype, chunk] = work[i];
+                EntityId* entities = archetype->entities(*chunk);
+                std::tuple<Ts*...> columns{archetype->template column<Ts>(*chunk)...};
+                for (uint32_t row = 0; row < chunk->count; ++row) {
+                    func(entities[row], rowRef<Ts>(std::get<Ts*>(columns), row)...);
+                }
+            }
+        });
+    }
+
+    Signature getSignature(EntityId entity) const {
+        const EntityLocation* location = find(entity);
+        return location ? archetypes[location->archetype]->signature : Signature();
+    }
+
+    size_t getArchetypeCount() const { return archetypes.size(); }
+
+    // Raw access for World snapshots.
+    // Calls func(const EntityId*, const std::byte* column, uint32_t count)
+    // for every non-empty chunk holding typeId.
+    template<typename Func>
+    void forEachColumn(ComponentTypeId typeId, Func&& func) const {
+        for (const auto& archetype : archetypes) {
+            if (!archetype->signature.test(typeId)) {
+                continue;
+            }
+            for (auto& chunk : archetype->chunks) {
+                if (chunk.count > 0) {
+                    func(archetype->entities(chunk),
+                         chunk.memory.get() + archetype->columnOffsets[typeId], chunk.count);
+                }
+            }
+        }
+    }
+
+    size_t countWith(ComponentTypeId typeId) const {
+        size_t count = 0;
+        for (const auto& archetype : archetypes) {
+            if (archetype->signature.test(typeId)) {
+                count += archetype->entityCount;
+            }
+        }
+        return count;
+    }
+
+    // Gives a component-less entity a row in the archetype for signature.
+    // Component bytes are left for the caller to fill in via rawComponent().
+    void place(EntityId entity, const Signature& signature) {
+        assert(!find(entity) && "Entity already has components.");
+        moveEntity(entity, signature);
+    }
+
+    std::byte* rawComponent(EntityId entity, ComponentTypeId typeId) {
+        assert(find(entity) && "Entity has no components.");
+        return componentData(entity, typeId);
+    }
+
+    // Drops every entity; registered component types are kept
+    void clear() {
+        archetypes.clear();
+        archetypeLookup.clear();
+        locations.clear();
+    }
+
+private:
+    template<typename T>
+    static T& rowRef(T* column, uint32_t row) {
+        if constexpr (std::is_empty_v<T>) {
+            return tagComponent<T>();
+        } else {
+            return column[row];
+        }
+    }
+
+    static constexpr uint32_t NO_ARCHETYPE = std::numeric_limits<uint32_t>::max();
+
+    struct ComponentInfo {
+        uint32_t size = 0;
+        uint32_t alignment = 0;
+        bool registered = false;
+    };
+
+    // Where an entity's row lives: archetype index + row across its chunks.
+    // Indexed by entity index; the stored handle rejects stale generations.
+    struct EntityLocation {
+        EntityId entity = INVALID_ENTITY;
+        uint32_t archetype = NO_ARCHETYPE;
+        uint32_t row = 0;
+    };
+
+    const EntityLocation* find(EntityId entity) const {
+        uint32_t index = entityIndex(entity);
+        if (index >= locations.size() || locations[index].entity != entity) {
+            return nullptr;
+        }
+        return &locations[index];
+    }
+
+    std::byte* componentData(EntityId entity, ComponentTypeId typeId) {
+        const EntityLocation& location = locations[entityIndex(entity)];
+        return rowData(*archetypes[location.archetype], location.row, typeId);
+    }
+
+    std::byte* rowData(Archetype& archetype, uint32_t row, ComponentTypeId typeId) {
+        ArchetypeChunk& chunk = archetype.chunks[row / archetype.chunkCapacity];
+        return chunk.memory.get() + archetype.columnOffsets[typeId] +
+               static_cast<size_t>(row % archetype.chunkCapacity) * componentInfo[typeId].size;
+    }
+
+    uint32_t findOrCreateArchetype(const Signature& signature);
+    void moveEntity(EntityId entity, const Signature& signature);
+    uint32_t allocateRow(Archetype& archetype, EntityId entity);
+    void freeRow(Archetype& archetype, uint32_t row);
+
+    std::vector<std::unique_ptr<Archetype>> archetypes;
+    std::unordered_map<Signature, uint32_t> archetypeLookup;
+    std::vector<EntityLocation> locations;
+    std::array<ComponentInfo, MAX_COMPONENTS> componentInfo{};
+};
+
+// World::view() result when archetype storage is selected
+template<typename... Ts>
+class ArchetypeView {
+public:
+    ArchetypeView(ArchetypeStorage& storage, ChangeTracking& changes)
+        : storage(storage), changes(changes) {
+        (markWritten<Ts>(written), ...);
+        written &= changes.tracked;
+    }
+
+    template<typename Func>
+    void each(Func&& func) {
+        if (written.none()) {
+            storage.each<std::remove_const_t<Ts>...>(std::forward<Func>(func));
+            return;
+        }
+        storage.each<std::remove_const_t<Ts>...>([&](EntityId entity, auto&... components) {
+            (markWritten<Ts>(entity), ...);
+            func(entity, components...);
+        });
+    }
+
+    // Work is split per chunk, so grainSize is not used here
+    template<typename Func>
+    void parallelEach(ThreadPool& threadPool, Func&& func, size_t /*grainSize*/ = 1024) {
+        if (written.none()) {
+            storage.parallelEach<std::remove_const_t<Ts>...>(threadPool, std::forward<Func>(func));
+            return;
+        }
+        storage.parallelEach<std::remove_const_t<Ts>...>(
+            threadPool, [&](EntityId entity, auto&... components) {
+            (markWritten<Ts>(entity), ...);
+            func(entity, components...);
+        });
+    }
+
+private:
+    template<typename T>
+    static void markWritten(Signature& signature) {
+        if constexpr (!std::is_const_v<T>) {
+            signature.set(getComponentTypeId<T>());
+        }
+    }
+
+    template<typename T>
+    void markWritten(EntityId entity) {
+        if constexpr (!std::is_const_v<T>) {
+            changes.mark(getComponentTypeId<T>(), entity);
+        }
+    }
+
+    ArchetypeStorage& storage;
+    ChangeTracking& changes;
+    Signature written; // Tracked non-const types
+};
+
+} // namespace engine
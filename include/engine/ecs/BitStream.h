@@ -0,0 +1,126 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+// Packs values of arbitrary bit width, least significant bit first
+class BitWriter {
+public:
+    explicit BitWriter(std::vector<std::byte>& buffer) : buffer(buffer) {}
+    ~BitWriter() { flush(); }
+
+    BitWriter(const BitWriter&) = delete;
+    BitWriter& operator=(const BitWriter&) = delete;
+
+    void writeBits(uint32_t value, uint32_t count) {
+        assert(count <= 32 && "At most 32 bits per write.");
+        if (count < 32) {
+            value &= (1u << count) - 1;
+        }
+        scratch |= static_cast<uint64_t>(value) << scratchBits;
+        scratchBits += count;
+        while (scratchBits >= 8) {
+            buffer.push_back(static_cast<std::byte>(scratch & 0xFF));
+            scratch >>= 8;
+            scratchBits -= 8;
+        }
+    }
+
+    void writeBool(bool value) { writeBits(value ? 1 : 0, 1); }
+
+    // Prefix code favouring small values: 5, 12, 20 or 35 bits on the wire
+    void writeVarUint(uint32_t value) {
+        if (value < (1u << 4)) {
+            writeBits(0b0, 1);
+            writeBits(value, 4);
+        } else if (value < (1u << 10)) {
+            writeBits(0b01, 2);
+            writeBits(value, 10);
+        } else if (value < (1u << 17)) {
+            writeBits(0b011, 3);
+            writeBits(value, 17);
+        } else {
+            writeBits(0b111, 3);
+            writeBits(value, 32);
+        }
+    }
+
+    // Zigzag-encoded so small negative values stay small
+    void writeVarInt(int32_t value) {
+        uint32_t bits = static_cast<uint32_t>(value);
+        writeVarUint((bits << 1) ^ (value < 0 ? 0xFFFFFFFFu : 0u));
+    }
+
+    // Pads the last partial byte with zeros
+    void flush() {
+        if (scratchBits > 0) {
+            buffer.push_back(static_cast<std::byte>(scratch & 0xFF));
+            scratch = 0;
+            scratchBits = 0;
+        }
+    }
+
+private:
+    std::vector<std::byte>& buffer;
+    uint64_t scratch = 0;
+    uint32_t scratchBits = 0;
+};
+
+// Reads what BitWriter wrote. Running out of data fails the reader and
+// yields zeros instead of asserting, since the bytes come from outside.
+class BitReader {
+public:
+    BitReader(const std::byte* data, size_t size) : data(data), size(size) {}
+
+    uint32_t readBits(uint32_t count) {
+        assert(count <= 32 && "At most 32 bits per read.");
+        while (scratchBits < count) {
+            if (offset == size) {
+                failed = true;
+                return 0;
+            }
+            scratch |= static_cast<uint64_t>(data[offset++]) << scratchBits;
+            scratchBits += 8;
+        }
+        uint32_t value = static_cast<uint32_t>(count < 32 ? scratch & ((1ull << count) - 1)
+                                                          : scratch & 0xFFFFFFFFull);
+        scratch >>= count;
+        scratchBits -= count;
+        return value;
+    }
+
+    bool readBool() { return readBits(1) != 0; }
+
+    uint32_t readVarUint() {
+        if (readBits(1) == 0) {
+            return readBits(4);
+        }
+        if (readBits(1) == 0) {
+            return readBits(10);
+        }
+        return readBits(1) == 0 ? readBits(17) : readBits(32);
+    }
+
+    int32_t readVarInt() {
+        uint32_t bits = readVarUint();
+        return static_cast<int32_t>((bits >> 1) ^ (0u - (bits & 1)));
+    }
+
+    bool hasFailed() const { return failed; }
+
+    // True once every whole byte has been consumed (padding bits are ignored)
+    bool atEnd() const { return offset == size; }
+
+private:
+    const std::byte* data;
+    size_t size;
+    size_t offset = 0;
+    uint64_t scratch = 0;
+    uint32_t scratchBits = 0;
+    bool failed = false;
+};
+
+} // namespace engine
@@ -0,0 +1,25 @@
+#pragma once
+#include "Entity.h"
+#include "Component.h"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+namespace engine {
+
+// Per-type change stamps, indexed by entity index. Tracked types get a stamp
+// vector as long as the entity slot table, so marking is a plain store and
+// parallel views can mark disjoint entities without locking.
+struct ChangeTracking {
+    std::array<std::vector<uint32_t>, MAX_COMPONENTS> ticks;
+    Signature tracked;
+    uint32_t tick = 1;
+
+    void mark(ComponentTypeId typeId, EntityId entity) {
+        if (tracked.test(typeId)) {
+            ticks[typeId][entityIndex(entity)] = tick;
+        }
+    }
+};
+
+} // namespace engine
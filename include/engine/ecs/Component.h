@@ -1,6 +1,9 @@
 #pragma once
+#include <atomic>
 #include <cstdint>
 #include <cstddef>
+#include <bitset>
+#include <type_traits>
 
 namespace engine {
 
@@ -8,8 +11,9 @@ namespace engine {
 using ComponentTypeId = uint32_t;
 
 namespace internal {
+    // Atomic so component types can be first used from worker threads
     inline ComponentTypeId getUniqueComponentId() {
-        static ComponentTypeId lastId = 0;
+        static std::atomic<ComponentTypeId> lastId{0};
         return lastId++;
     }
 }
@@ -24,4 +28,16 @@ inline ComponentTypeId getComponentTypeId() {
 // Maximum number of component types supported
 constexpr size_t MAX_COMPONENTS = 32;
 
+// Empty (tag) components carry no data, so storage never keeps instances of
+// them; accessors hand out this shared one instead.
+template <typename T>
+inline T& tagComponent() {
+    static_assert(std::is_empty_v<T>, "Only empty component types are tags.");
+    static T instance;
+    return instance;
+}
+
+// Set of component types an entity (or archetype) has
+using Signature = std::bitset<MAX_COMPONENTS>;
+
 } // namespace engine
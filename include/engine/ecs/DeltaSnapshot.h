@@ -0,0 +1,133 @@
+#pragma once
+#include "World.h"
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <initializer_list>
+#include <type_traits>
+#include <vector>
+
+namespace engine {
+
+// Which components are replicated and how their fields are encoded. Every
+// component is treated as a row of 32-bit fields; a field with a precision
+// is a float quantized to that step, the rest are sent bit-exact.
+// Encoder and decoder must build the same schema in the same order.
+class ReplicationSchema {
+public:
+    template<typename T>
+    void add(std::initializer_list<float> precisions = {}) {
+        static_assert(std::is_trivially_copyable_v<T>, "Replicated components are copied bitwise.");
+        Component component;
+        component.typeId = getComponentTypeId<T>();
+        component.fieldCount = std::is_empty_v<T> ? 0 : (sizeof(T) + 3) / 4;
+        component.precision.assign(precisions);
+        assert(component.precision.size() <= component.fieldCount && "Too many precisions.");
+        component.precision.resize(component.fieldCount, 0.0f);
+        component.fieldOffset = fieldCount;
+        component.read = [](World& world, EntityId entity, uint32_t* fields) {
+            if constexpr (!std::is_empty_v<T>) {
+                std::memcpy(fields, &world.readComponent<T>(entity), sizeof(T));
+            }
+        };
+        component.write = [](World& world, EntityId entity, const uint32_t* fields) {
+            if (!world.hasComponent<T>(entity)) {
+                world.addComponent(entity, T{});
+            }
+            if constexpr (!std::is_empty_v<T>) {
+                std::memcpy(&world.getComponent<T>(entity), fields, sizeof(T));
+            }
+        };
+        component.remove = [](World& world, EntityId entity) {
+            world.removeComponent<T>(entity);
+        };
+
+        assert(components.size() < 32 && "Too many replicated components.");
+        fieldCount += component.fieldCount;
+        mask.set(component.typeId);
+        components.push_back(std::move(component));
+    }
+
+    size_t size() const { return components.size(); }
+
+private:
+    friend class DeltaEncoder;
+    friend class DeltaDecoder;
+
+    struct Component {
+        ComponentTypeId typeId = 0;
+        uint32_t fieldCount = 0;
+        uint32_t fieldOffset = 0;     // Into a slot's row of baseline fields
+        std::vector<float> precision; // Per field, 0 = raw bits
+        void (*read)(World&, EntityId, uint32_t* fields) = nullptr;
+        void (*write)(World&, EntityId, const uint32_t* fields) = nullptr;
+        void (*remove)(World&, EntityId) = nullptr;
+    };
+
+    std::vector<Component> components;
+    uint32_t fieldCount = 0; // Total fields across components
+    Signature mask;          // Replicated type IDs
+};
+
+// State both ends agree on after the last delta: per entity slot, the
+// replicated handle, which components it had and their encoded fields
+// (quantized integers or raw bits).
+struct DeltaBaseline {
+    std::vector<EntityId> handles;
+    std::vector<uint32_t> presence; // Bit i = schema component i
+    std::vector<uint32_t> fields;   // schema fieldCount words per slot
+
+    void resize(size_t slotCount, uint32_t fieldCount) {
+        handles.resize(slotCount, INVALID_ENTITY);
+        presence.resize(slotCount, 0);
+        fields.resize(slotCount * fieldCount, 0);
+    }
+};
+
+// Encodes a World as a bit-packed delta against the previous encode. Only
+// entities that were created, destroyed or whose quantized fields changed are
+// written, and only the changed fields of those. When every replicated type
+// has change tracking enabled, untouched entities are skipped without being
+// compared. Deltas must reach the decoder reliably and in order; the first
+// one (against an empty baseline) carries the full state.
+class DeltaEncoder {
+public:
+    explicit DeltaEncoder(const ReplicationSchema& schema) : schema(schema) {}
+
+    // Appends the delta since the last encode() and makes it the new baseline
+    void encode(World& world, std::vector<std::byte>& out);
+
+    uint32_t getSequence() const { return sequence; }
+
+private:
+    const ReplicationSchema& schema;
+    DeltaBaseline baseline;
+    uint32_t sequence = 0;
+    uint32_t lastChangeTick = 0;
+    bool hasEncoded = false;
+    std::vector<uint32_t> scratch;
+};
+
+// Applies deltas from a DeltaEncoder to a World. Remote entities are created
+// locally, so their handles differ; toLocal() maps between them.
+class DeltaDecoder {
+public:
+    explicit DeltaDecoder(const ReplicationSchema& schema) : schema(schema) {}
+
+    // False if the delta is malformed or out of sequence. The World may then
+    // be partially updated and needs a resync from a full snapshot.
+    bool decode(World& world, const std::byte* data, size_t size);
+
+    EntityId toLocal(EntityId remote) const;
+
+    uint32_t getSequence() const { return sequence; }
+
+private:
+    const ReplicationSchema& schema;
+    DeltaBaseline baseline;
+    std::vector<EntityId> localHandles; // Per remote slot
+    uint32_t sequence = 0;
+    std::vector<uint32_t> scratch;
+};
+
+} // namespace engine
@@ -4,13 +4,35 @@
 
 namespace engine {
 
-// Entity is just an ID
+// Entity handle: the low bits index into entity storage, the high bits hold
+// a generation that is bumped every time the index is recycled, so handles
+// to destroyed entities never alias newer ones. A slot whose generation
+// would wrap is retired instead of reused.
 using EntityId = uint32_t;
 
+constexpr uint32_t ENTITY_INDEX_BITS = 20;
+constexpr uint32_t ENTITY_GENERATION_BITS = 32 - ENTITY_INDEX_BITS;
+constexpr uint32_t ENTITY_INDEX_MASK = (1u << ENTITY_INDEX_BITS) - 1;
+constexpr uint32_t ENTITY_GENERATION_MASK = (1u << ENTITY_GENERATION_BITS) - 1;
+
 // Invalid entity constant
 constexpr EntityId INVALID_ENTITY = std::numeric_limits<EntityId>::max();
 
-// Maximum number of entities supported
-constexpr EntityId MAX_ENTITIES = 10000;
+// Upper bound on simultaneously alive entities. Storage is allocated on
+// demand as entities are created, so this is a limit, not a reservation.
+// The all-ones index is reserved so no live handle equals INVALID_ENTITY.
+constexpr EntityId MAX_ENTITIES = ENTITY_INDEX_MASK;
+
+constexpr uint32_t entityIndex(EntityId entity) {
+    return entity & ENTITY_INDEX_MASK;
+}
+
+constexpr uint32_t entityGeneration(EntityId entity) {
+    return entity >> ENTITY_INDEX_BITS;
+}
+
+constexpr EntityId makeEntityId(uint32_t index, uint32_t generation) {
+    return ((generation & ENTITY_GENERATION_MASK) << ENTITY_INDEX_BITS) | (index & ENTITY_INDEX_MASK);
+}
 
 } // namespace engine
@@ -0,0 +1,39 @@
+#pragma once
+#include "System.h"
+#include "engine/core/Profiler.h"
+#include "engine/core/ThreadPool.h"
+#include <memory>
+#include <vector>
+
+namespace engine {
+
+// Runs systems once per tick. Systems are grouped into stages from their
+// declared SystemAccess: a system lands in the stage after the last earlier
+// system it conflicts with, so conflicting systems keep registration order
+// and results match a serial run. Systems within a stage run in parallel.
+// With a profiler, each system's update is timed as a section named after it.
+class Scheduler {
+public:
+    explicit Scheduler(ThreadPool& threadPool, Profiler* profiler = nullptr)
+        : threadPool(threadPool), profiler(profiler) {}
+
+    System& addSystem(std::unique_ptr<System> system);
+
+    void update(World& world, float dt);
+
+    size_t getStageCount();
+    size_t getSystemCount() const { return systems.size(); }
+
+private:
+    void buildStages();
+    void runSystem(size_t index, World& world, float dt);
+
+    ThreadPool& threadPool;
+    Profiler* profiler;
+    std::vector<std::unique_ptr<System>> systems;
+    std::vector<uint32_t> profileSections; // Per system, with a profiler
+    std::vector<std::vector<size_t>> stages; // Indices into systems
+    bool stagesDirty = false;
+};
+
+} // namespace engine
@@ -0,0 +1,110 @@
+#pragma once
+#include <cassert>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+#include <vector>
+
+namespace engine {
+
+// World snapshot format (native byte order, all fields 32-bit unless noted):
+//
+//   magic "ESNP", version (u16), reserved (u16)
+//   componentCount, elementSize[componentCount]    registration order
+//   slotCount, freeListHead, livingEntityCount
+//   slots[slotCount]                               entity slot table
+//   signatures[slotCount]                          bit i = i-th registered type
+//   per data component: count, entities[count], component payload
+//
+// Element size is 0 for tags and SNAPSHOT_CUSTOM_ELEMENT for components
+// written through a ComponentSerializer specialization.
+constexpr uint32_t SNAPSHOT_MAGIC = 0x504E5345; // "ESNP"
+constexpr uint16_t SNAPSHOT_VERSION = 1;
+constexpr uint32_t SNAPSHOT_CUSTOM_ELEMENT = 0xFFFFFFFF;
+
+// Appends raw bytes to a growing buffer
+class SnapshotWriter {
+public:
+    explicit SnapshotWriter(std::vector<std::byte>& buffer) : buffer(buffer) {}
+
+    void writeBytes(const void* data, size_t size) {
+        size_t offset = buffer.size();
+        buffer.resize(offset + size);
+        if (size > 0) {
+            std::memcpy(buffer.data() + offset, data, size);
+        }
+    }
+
+    template<typename T>
+    void write(const T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values.");
+        writeBytes(&value, sizeof(T));
+    }
+
+private:
+    std::vector<std::byte>& buffer;
+};
+
+// Bounds-checked cursor over snapshot bytes. Reading past the end fails the
+// reader instead of asserting, since snapshots may come from disk or network.
+class SnapshotReader {
+public:
+    SnapshotReader(const std::byte* data, size_t size) : data(data), size(size) {}
+
+    bool readBytes(void* out, size_t count) {
+        if (failed || count > size - offset) {
+            failed = true;
+            return false;
+        }
+        if (count > 0) {
+            std::memcpy(out, data + offset, count);
+        }
+        offset += count;
+        return true;
+    }
+
+    template<typename T>
+    bool read(T& value) {
+        static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values.");
+        return readBytes(&value, sizeof(T));
+    }
+
+    // True if at least count elements of elementSize bytes remain
+    bool canRead(size_t count, size_t elementSize) const {
+        return !failed && (elementSize == 0 || count <= (size - offset) / elementSize);
+    }
+
+    bool hasFailed() const { return failed; }
+    size_t remaining() const { return size - offset; }
+
+private:
+    const std::byte* data;
+    size_t size;
+    size_t offset = 0;
+    bool failed = false;
+};
+
+// How a component type is written to snapshots. Trivially copyable types are
+// copied in bulk; specialize this for anything else, e.g.
+//
+//   template<> struct ComponentSerializer<Name> {
+//       static constexpr bool bulk = false;
+//       static void write(SnapshotWriter& writer, const Name& name);
+//       static bool read(SnapshotReader& reader, Name& name);
+//   };
+template<typename T>
+struct ComponentSerializer {
+    static constexpr bool bulk = std::is_trivially_copyable_v<T>;
+
+    static void write(SnapshotWriter&, const T&) {
+        assert(false && "Component needs a ComponentSerializer specialization.");
+    }
+
+    static bool read(SnapshotReader&, T&) {
+        assert(false && "Component needs a ComponentSerializer specialization.");
+        return false;
+    }
+};
+
+} // namespace engine
@@ -0,0 +1,86 @@
+#pragma once
+#include "Entity.h"
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace engine {
+
+// Uniform grid over a fixed rectangle. Entries are rebuilt in bulk each tick
+// (clear, insert..., build) into one contiguous array sorted by cell, so
+// steady-state rebuilds don't allocate. Each entry is bucketed by its
+// position and carries a bounding box used by range queries; positions
+// outside the grid bounds are clamped into the border cells.
+class SpatialGrid {
+public:
+    SpatialGrid(float minX, float minY, float maxX, float maxY, float cellSize);
+
+    void clear();
+    void insert(EntityId entity, float x, float y,
+                float boundsMinX, float boundsMinY, float boundsMaxX, float boundsMaxY);
+    void build();
+
+    // Calls func(EntityId) for every entry whose bounding box overlaps the rectangle
+    template<typename Func>
+    void queryRange(float minX, float minY, float maxX, float maxY, Func&& func) const {
+        // Boxes can stick out of their cell by up to maxExtent
+        int x0 = cellX(minX - maxExtent), x1 = cellX(maxX + maxExtent);
+        int y0 = cellY(minY - maxExtent), y1 = cellY(maxY + maxExtent);
+        for (int cy = y0; cy <= y1; ++cy) {
+            for (int cx = x0; cx <= x1; ++cx) {
+                size_t cell = static_cast<size_t>(cy) * columns + static_cast<size_t>(cx);
+                for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+                    const Entry& entry = entries[i];
+                    if (entry.maxX >= minX && entry.minX <= maxX &&
+                        entry.maxY >= minY && entry.minY <= maxY) {
+                        func(entry.entity);
+                    }
+                }
+            }
+        }
+    }
+
+    void queryRange(float minX, float minY, float maxX, float maxY,
+                    std::vector<EntityId>& out) const;
+
+    // Entry whose position is closest to (x, y) within maxDistance, or INVALID_ENTITY
+    EntityId nearest(float x, float y,
+                     float maxDistance = std::numeric_limits<float>::infinity()) const;
+
+    // True if the entity was inserted before the last build()
+    bool contains(EntityId entity) const {
+        size_t index = entityIndex(entity);
+        return index < indexed.size() && indexed[index] == entity;
+    }
+
+    size_t size() const { return entries.size(); }
+    float getCellSize() const { return cellSize; }
+
+private:
+    struct Entry {
+        EntityId entity;
+        float x, y;
+        float minX, minY, maxX, maxY;
+    };
+
+    int cellX(float x) const {
+        return std::clamp(static_cast<int>((x - originX) * inverseCellSize), 0, columns - 1);
+    }
+    int cellY(float y) const {
+        return std::clamp(static_cast<int>((y - originY) * inverseCellSize), 0, rows - 1);
+    }
+
+    float originX, originY;
+    float cellSize, inverseCellSize;
+    int columns, rows;
+    float maxExtent = 0.0f; // Largest distance from an entry's position to its box edge
+
+    std::vector<Entry> pending;       // Inserted since clear(), unsorted
+    std::vector<uint32_t> pendingCell;
+    std::vector<Entry> entries;       // Built entries, grouped by cell
+    std::vector<uint32_t> cellStart;  // Entries of cell c are [cellStart[c], cellStart[c + 1])
+    std::vector<EntityId> indexed;    // Built entity per entity index, for contains()
+};
+
+} // namespace engine
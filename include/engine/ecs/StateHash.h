@@ -0,0 +1,93 @@
+#pragma once
+#include "Entity.h"
+#include "Component.h"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace engine {
+
+class World;
+
+// XXH64 over a byte range, reading words in native byte order
+inline uint64_t hashBytes(const void* data, size_t size, uint64_t seed = 0) {
+    constexpr uint64_t PRIME1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t PRIME2 = 0xC2B2AE3D27D4EB4Full;
+    constexpr uint64_t PRIME3 = 0x165667B19E3779F9ull;
+    constexpr uint64_t PRIME4 = 0x85EBCA77C2B2AE63ull;
+    constexpr uint64_t PRIME5 = 0x27D4EB2F165667C5ull;
+    auto rotl = [](uint64_t x, int r) { return (x << r) | (x >> (64 - r)); };
+    auto round = [&](uint64_t acc, uint64_t lane) {
+        return rotl(acc + lane * PRIME2, 31) * PRIME1;
+    };
+    auto merge = [&](uint64_t acc, uint64_t lane) {
+        return (acc ^ round(0, lane)) * PRIME1 + PRIME4;
+    };
+    auto read64 = [](const unsigned char* p) {
+        uint64_t v;
+        std::memcpy(&v, p, sizeof(v));
+        return v;
+    };
+
+    const auto* p = static_cast<const unsigned char*>(data);
+    const unsigned char* end = p + size;
+    uint64_t h;
+    if (size >= 32) {
+        uint64_t v1 = seed + PRIME1 + PRIME2;
+        uint64_t v2 = seed + PRIME2;
+        uint64_t v3 = seed;
+        uint64_t v4 = seed - PRIME1;
+        for (; end - p >= 32; p += 32) {
+            v1 = round(v1, read64(p));
+            v2 = round(v2, read64(p + 8));
+            v3 = round(v3, read64(p + 16));
+            v4 = round(v4, read64(p + 24));
+        }
+        h = rotl(v1, 1) + rotl(v2, 7) + rotl(v3, 12) + rotl(v4, 18);
+        h = merge(merge(merge(merge(h, v1), v2), v3), v4);
+    } else {
+        h = seed + PRIME5;
+    }
+    h += size;
+
+    for (; end - p >= 8; p += 8) {
+        h = rotl(h ^ round(0, read64(p)), 27) * PRIME1 + PRIME4;
+    }
+    if (end - p >= 4) {
+        uint32_t v;
+        std::memcpy(&v, p, sizeof(v));
+        h = rotl(h ^ (v * PRIME1), 23) * PRIME2 + PRIME3;
+        p += 4;
+    }
+    for (; p < end; ++p) {
+        h = rotl(h ^ (*p * PRIME5), 11) * PRIME1;
+    }
+
+    h ^= h >> 33;
+    h *= PRIME2;
+    h ^= h >> 29;
+    h *= PRIME3;
+    h ^= h >> 32;
+    return h;
+}
+
+// Running World fingerprint. Every (entity, component) pair contributes a
+// hash of its handle, type and bytes; contributions are summed, so the total
+// doesn't depend on storage order and one entry can be swapped out in O(1).
+// Entries are refreshed from the change-tracking stamps. Types are identified
+// by registration order, as in snapshots, so processes that assigned type IDs
+// differently still agree.
+struct StateHash {
+    using Hasher = uint64_t (*)(World&, EntityId, uint64_t seed);
+
+    Signature hashed;
+    std::array<Hasher, MAX_COMPONENTS> hashers{};
+    std::array<uint64_t, MAX_COMPONENTS> seeds{}; // Registration index << 32
+    std::array<std::vector<uint64_t>, MAX_COMPONENTS> contributions; // By entity index
+    uint64_t total = 0;
+    uint32_t lastTick = 0;
+};
+
+} // namespace engine
@@ -3,10 +3,40 @@
 
 namespace engine {
 
+// Component types a system touches. The scheduler runs two systems in
+// parallel only if neither writes something the other reads or writes.
+struct SystemAccess {
+    Signature reads;
+    Signature writes;
+    bool exclusive = false; // Structural changes or unknown access: runs alone
+
+    bool conflictsWith(const SystemAccess& other) const {
+        return exclusive || other.exclusive ||
+               (writes & (other.reads | other.writes)).any() || (other.writes & reads).any();
+    }
+};
+
+// Builds a signature from a list of component types
+template<typename... Ts>
+inline Signature componentSignature() {
+    Signature signature;
+    (signature.set(getComponentTypeId<Ts>()), ...);
+    return signature;
+}
+
 class System {
 public:
     virtual ~System() = default;
     virtual void update(World& world, float dt) = 0;
+
+    // Systems that don't declare their access are treated as exclusive
+    virtual SystemAccess getAccess() const { return {Signature(), Signature(), true}; }
+
+    // Systems calling thread-affine APIs (GLFW, OpenGL) stay on the calling thread
+    virtual bool requiresMainThread() const { return false; }
+
+    // Shown in profiler output
+    virtual const char* getName() const { return "System"; }
 };
 
 } // namespace engine
@@ -1,13 +1,21 @@
 #pragma once
 #include "Entity.h"
 #include "Component.h"
+#include "ArchetypeStorage.h"
+#include "ChangeTracking.h"
+#include "Snapshot.h"
+#include "StateHash.h"
+#include "engine/core/ThreadPool.h"
+#include <array>
 #include <vector>
-#include <queue>
 #include <bitset>
 #include <memory>
 #include <cassert>
-#include <typeindex>
-#include <unordered_map>
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <tuple>
+#include <type_traits>
 
 namespace engine {
 
@@ -16,135 +24,563 @@ class IComponentArray {
 public:
     virtual ~IComponentArray() = default;
     virtual void entityDestroyed(EntityId entity) = 0;
+    virtual bool hasData(EntityId entity) const = 0;
+    virtual size_t size() const = 0;
+    virtual void clear() = 0;
+
+    // Writes count, entity handles and components (see Snapshot.h)
+    virtual void serialize(SnapshotWriter& writer) const = 0;
+    // Replaces the contents with serialized data; false if it is malformed
+    virtual bool deserialize(SnapshotReader& reader) = 0;
 };
 
-// Concrete storage for a specific component type
+// Concrete storage for a specific component type.
+//
+// Sparse set layout: a paged sparse array maps entity index -> dense index,
+// while two dense arrays keep entity handles and components packed side by
+// side for linear iteration. Lookups are a few array loads, no hashing, and
+// comparing the stored handle rejects stale generations.
 template<typename T>
-class ComponentArray : public IComponentArray {
+class ComponentArray final : public IComponentArray {
 public:
     void insertData(EntityId entity, T component) {
-        size_t newIndex = size;
-        entityToIndexMap[entity] = newIndex;
-        indexToEntityMap[newIndex] = entity;
-        componentArray[newIndex] = component;
-        size++;
+        assert(!hasData(entity) && "Component added to same entity more than once.");
+
+        size_t index = denseEntities.size();
+        if (index / DENSE_PAGE_SIZE == componentPages.size()) {
+            componentPages.push_back(std::make_unique<T[]>(DENSE_PAGE_SIZE));
+        }
+
+        sparseSlot(entity) = static_cast<uint32_t>(index);
+        denseEntities.push_back(entity);
+        denseAt(index) = std::move(component);
     }
 
     void removeData(EntityId entity) {
-        assert(entityToIndexMap.find(entity) != entityToIndexMap.end() && "Removing non-existent component.");
+        assert(hasData(entity) && "Removing non-existent component.");
 
-        // Copy last element into deleted element's place to keep array packed
-        size_t indexOfRemovedEntity = entityToIndexMap[entity];
-        size_t indexOfLastElement = size - 1;
-        
-        componentArray[indexOfRemovedEntity] = componentArray[indexOfLastElement];
+        // Move last element into deleted element's place to keep array packed
+        uint32_t indexOfRemovedEntity = sparseSlot(entity);
+        uint32_t indexOfLastElement = static_cast<uint32_t>(denseEntities.size() - 1);
+        EntityId entityOfLastElement = denseEntities[indexOfLastElement];
+
+        denseAt(indexOfRemovedEntity) = std::move(denseAt(indexOfLastElement));
+        denseEntities[indexOfRemovedEntity] = entityOfLastElement;
 
-        // Update map to point to moved spot
-        EntityId entityOfLastElement = indexToEntityMap[indexOfLastElement];
-        entityToIndexMap[entityOfLastElement] = indexOfRemovedEntity;
-        indexToEntityMap[indexOfRemovedEntity] = entityOfLastElement;
+        // Update sparse entries to point to moved spot
+        sparseSlot(entityOfLastElement) = indexOfRemovedEntity;
+        sparseSlot(entity) = INVALID_INDEX;
 
-        entityToIndexMap.erase(entity);
-        indexToEntityMap.erase(indexOfLastElement);
+        denseEntities.pop_back();
 
-        size--;
+        // Release trailing pages, keeping one spare to avoid thrashing at a boundary
+        size_t pagesInUse = (denseEntities.size() + DENSE_PAGE_SIZE - 1) / DENSE_PAGE_SIZE;
+        while (componentPages.size() > pagesInUse + 1) {
+            componentPages.pop_back();
+        }
     }
 
     T& getData(EntityId entity) {
-        assert(entityToIndexMap.find(entity) != entityToIndexMap.end() && "Retrieving non-existent component.");
-        return componentArray[entityToIndexMap[entity]];
+        assert(hasData(entity) && "Retrieving non-existent component.");
+        uint32_t index = entityIndex(entity);
+        return denseAt(sparsePages[index / PAGE_SIZE][index % PAGE_SIZE]);
     }
 
-    bool hasData(EntityId entity) const {
-        return entityToIndexMap.find(entity) != entityToIndexMap.end();
+    bool hasData(EntityId entity) const override {
+        uint32_t index = entityIndex(entity);
+        size_t page = index / PAGE_SIZE;
+        if (page >= sparsePages.size() || !sparsePages[page]) {
+            return false;
+        }
+        uint32_t denseIndex = sparsePages[page][index % PAGE_SIZE];
+        return denseIndex != INVALID_INDEX && denseEntities[denseIndex] == entity;
     }
 
     void entityDestroyed(EntityId entity) override {
-        if (entityToIndexMap.find(entity) != entityToIndexMap.end()) {
+        if (hasData(entity)) {
             removeData(entity);
         }
     }
 
+    size_t size() const override { return denseEntities.size(); }
+
+    // Packed entity handles, in the same order as the components
+    const std::vector<EntityId>& entities() const { return denseEntities; }
+
+    void clear() override {
+        sparsePages.clear();
+        denseEntities.clear();
+        componentPages.clear();
+    }
+
+    void serialize(SnapshotWriter& writer) const override {
+        uint32_t count = static_cast<uint32_t>(denseEntities.size());
+        writer.write(count);
+        writer.writeBytes(denseEntities.data(), count * sizeof(EntityId));
+
+        if constexpr (ComponentSerializer<T>::bulk) {
+            // One copy per dense page
+            for (size_t begin = 0; begin < count; begin += DENSE_PAGE_SIZE) {
+                size_t pageCount = std::min<size_t>(DENSE_PAGE_SIZE, count - begin);
+                writer.writeBytes(componentPages[begin / DENSE_PAGE_SIZE].get(),
+                                  pageCount * sizeof(T));
+            }
+        } else {
+            for (size_t i = 0; i < count; ++i) {
+                ComponentSerializer<T>::write(
+                    writer, componentPages[i / DENSE_PAGE_SIZE][i % DENSE_PAGE_SIZE]);
+            }
+        }
+    }
+
+    bool deserialize(SnapshotReader& reader) override {
+        clear();
+
+        uint32_t count = 0;
+        if (!reader.read(count) || !reader.canRead(count, sizeof(EntityId))) {
+            return false;
+        }
+        denseEntities.resize(count);
+        reader.readBytes(denseEntities.data(), count * sizeof(EntityId));
+
+        for (size_t begin = 0; begin < count; begin += DENSE_PAGE_SIZE) {
+            size_t pageCount = std::min<size_t>(DENSE_PAGE_SIZE, count - begin);
+            componentPages.push_back(std::make_unique<T[]>(DENSE_PAGE_SIZE));
+            if constexpr (ComponentSerializer<T>::bulk) {
+                if (!reader.readBytes(componentPages.back().get(), pageCount * sizeof(T))) {
+                    return false;
+                }
+            } else {
+                for (size_t i = 0; i < pageCount; ++i) {
+                    if (!ComponentSerializer<T>::read(reader, componentPages.back()[i])) {
+                        return false;
+                    }
+                }
+            }
+        }
+
+        // Rebuild the sparse side; a handle listed twice is malformed
+        for (uint32_t i = 0; i < count; ++i) {
+            if (hasData(denseEntities[i])) {
+                return false;
+            }
+            sparseSlot(denseEntities[i]) = i;
+        }
+        return true;
+    }
+
 private:
-    // Packed array of components
-    std::array<T, MAX_ENTITIES> componentArray;
-    
-    // Map from entity ID to array index
-    std::unordered_map<EntityId, size_t> entityToIndexMap;
-    
-    // Map from array index to entity ID
-    std::unordered_map<size_t, EntityId> indexToEntityMap;
-    
-    size_t size = 0;
+    // Entities per sparse page; pages are only allocated once touched
+    static constexpr size_t PAGE_SIZE = 4096;
+
+    // Components per dense page. Pages never move, so references returned by
+    // getData stay valid while other entities gain this component. Removing
+    // one moves the last component into its slot and may free trailing
+    // pages, which invalidates references.
+    static constexpr size_t DENSE_PAGE_SIZE = 1024;
+    static constexpr uint32_t INVALID_INDEX = std::numeric_limits<uint32_t>::max();
+
+    // Returns the sparse entry for an entity, allocating its page on demand
+    uint32_t& sparseSlot(EntityId entity) {
+        uint32_t index = entityIndex(entity);
+        size_t page = index / PAGE_SIZE;
+        if (page >= sparsePages.size()) {
+            sparsePages.resize(page + 1);
+        }
+        if (!sparsePages[page]) {
+            sparsePages[page] = std::make_unique<uint32_t[]>(PAGE_SIZE);
+            std::fill_n(sparsePages[page].get(), PAGE_SIZE, INVALID_INDEX);
+        }
+        return sparsePages[page][index % PAGE_SIZE];
+    }
+
+    T& denseAt(size_t index) {
+        return componentPages[index / DENSE_PAGE_SIZE][index % DENSE_PAGE_SIZE];
+    }
+
+    // Sparse: entity index -> index into the dense arrays
+    std::vector<std::unique_ptr<uint32_t[]>> sparsePages;
+
+    // Dense: packed entity handles and their components (same order)
+    std::vector<EntityId> denseEntities;
+    std::vector<std::unique_ptr<T[]>> componentPages;
+};
+
+// Iterates every entity that has all of Ts... and hands out references to
+// the requested components. Matching is a single signature test per entity;
+// only the smallest data pool is walked, so tags filter without touching
+// component memory. A view of tags only walks the entity slot table.
+// Non-const types count as written and are marked changed when tracked;
+// use view<const T>() for read-only access.
+template<typename... Ts>
+class View {
+public:
+    View(const std::vector<EntityId>& entities, const std::vector<Signature>& signatures,
+         ChangeTracking& changes, ComponentArray<std::remove_const_t<Ts>>*... arrays)
+        : entities(&entities), signatures(&signatures), changes(&changes), arrays(arrays...) {
+        (required.set(getComponentTypeId<std::remove_const_t<Ts>>()), ...);
+        (markWritten<Ts>(written), ...);
+        written &= changes.tracked;
+    }
+
+    // Calls func(EntityId, Ts&...) for each matching entity. Iteration runs
+    // back to front, so destroying the current entity inside func is safe.
+    template<typename Func>
+    void each(Func&& func) {
+        const std::vector<EntityId>* candidates = smallestPool();
+        if (!candidates) {
+            for (size_t i = entities->size(); i-- > 0;) {
+                visitSlot(i, func);
+            }
+            return;
+        }
+        for (size_t i = candidates->size(); i-- > 0;) {
+            if (i < candidates->size()) {
+                visit((*candidates)[i], func);
+            }
+        }
+    }
+
+    // Like each(), but splits the candidates into grainSize slices that run
+    // across the pool. func may only write the components it is handed and
+    // must not create, destroy or restructure entities.
+    template<typename Func>
+    void parallelEach(ThreadPool& threadPool, Func&& func, size_t grainSize = 1024) {
+        const std::vector<EntityId>* candidates = smallestPool();
+        size_t count = candidates ? candidates->size() : entities->size();
+        threadPool.parallelFor(count, grainSize, [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) {
+                if (candidates) {
+                    visit((*candidates)[i], func);
+                } else {
+                    visitSlot(i, func);
+                }
+            }
+        });
+    }
+
+private:
+    template<typename Func>
+    void visit(EntityId entity, Func& func) {
+        if (((*signatures)[entityIndex(entity)] & required) == required) {
+            if (written.any()) {
+                (markWritten<Ts>(entity), ...);
+            }
+            func(entity, component<Ts>(entity)...);
+        }
+    }
+
+    template<typename Func>
+    void visitSlot(size_t index, Func& func) {
+        EntityId entity = (*entities)[index];
+        if (entityIndex(entity) == index) {
+            visit(entity, func);
+        }
+    }
+
+    template<typename T>
+    void markWritten(Signature& signature) {
+        if constexpr (!std::is_const_v<T>) {
+            signature.set(getComponentTypeId<T>());
+        }
+    }
+
+    template<typename T>
+    void markWritten(EntityId entity) {
+        if constexpr (!std::is_const_v<T>) {
+            changes->mark(getComponentTypeId<T>(), entity);
+        }
+    }
+
+    template<typename T>
+    T& component(EntityId entity) {
+        using Component = std::remove_const_t<T>;
+        if constexpr (std::is_empty_v<T>) {
+            return tagComponent<Component>();
+        } else {
+            return std::get<ComponentArray<Component>*>(arrays)->getData(entity);
+        }
+    }
+
+    // Dense entity list of the smallest data pool, or null for tag-only views
+    const std::vector<EntityId>* smallestPool() const {
+        const std::vector<EntityId>* smallest = nullptr;
+        auto consider = [&](auto* array) {
+            if (array && (!smallest || array->size() < smallest->size())) {
+                smallest = &array->entities();
+            }
+        };
+        (consider(std::get<ComponentArray<std::remove_const_t<Ts>>*>(arrays)), ...);
+        return smallest;
+    }
+
+    const std::vector<EntityId>* entities;
+    const std::vector<Signature>* signatures;
+    ChangeTracking* changes;
+    Signature required;
+    Signature written; // Tracked non-const types
+    std::tuple<ComponentArray<std::remove_const_t<Ts>>*...> arrays; // Null for tag components
 };
 
 class World {
 public:
-    World();
+    World() = default;
     ~World() = default;
 
     // Entity Management
     EntityId createEntity();
     void destroyEntity(EntityId entity);
+
+    // True if the handle refers to a live entity (false once destroyed,
+    // even after its index has been reused)
+    bool isAlive(EntityId entity) const {
+        uint32_t index = entityIndex(entity);
+        return index < entities.size() && entities[index] == entity;
+    }
     
     // Component Management
     template<typename T>
     void registerComponent() {
-        const char* typeName = typeid(T).name();
-        assert(componentTypes.find(typeName) == componentTypes.end() && "Registering component type more than once.");
+        ComponentTypeId typeId = getComponentTypeId<T>();
+        assert(typeId < MAX_COMPONENTS && "Too many component types.");
+        assert(!registeredComponents.test(typeId) && "Registering component type more than once.");
 
-        componentTypes.insert({typeName, getComponentTypeId<T>()});
-        componentArrays.insert({typeName, std::make_shared<ComponentArray<T>>()});
+        registeredComponents.set(typeId);
+        registrationOrder.push_back(typeId);
+        if constexpr (std::is_empty_v<T>) {
+            snapshotElementSizes[typeId] = 0;
+        } else {
+            snapshotElementSizes[typeId] = ComponentSerializer<T>::bulk
+                                               ? static_cast<uint32_t>(sizeof(T))
+                                               : SNAPSHOT_CUSTOM_ELEMENT;
+        }
+#ifdef ENGINE_ECS_ARCHETYPES
+        archetypes.registerComponent<T>();
+#else
+        // Tags carry no data: they live purely in the entity signature
+        if constexpr (!std::is_empty_v<T>) {
+            componentArrays[typeId] = std::make_unique<ComponentArray<T>>();
+        }
+#endif
     }
 
     template<typename T>
     void addComponent(EntityId entity, T component) {
-        getComponentArray<T>()->insertData(entity, component);
+        assert(isAlive(entity) && "Adding component to dead entity.");
+#ifdef ENGINE_ECS_ARCHETYPES
+        archetypes.add(entity, component);
+#else
+        if constexpr (std::is_empty_v<T>) {
+            assert(!signatures[entityIndex(entity)].test(getComponentTypeId<T>()) &&
+                   "Component added to same entity more than once.");
+        } else {
+            getComponentArray<T>().insertData(entity, component);
+        }
+#endif
         
-        auto signature = signatures[entity];
-        signature.set(getComponentTypeId<T>(), true);
-        signatures[entity] = signature;
+        signatures[entityIndex(entity)].set(getComponentTypeId<T>(), true);
+        changes.mark(getComponentTypeId<T>(), entity);
     }
 
     template<typename T>
     void removeComponent(EntityId entity) {
-        getComponentArray<T>()->removeData(entity);
+#ifdef ENGINE_ECS_ARCHETYPES
+        archetypes.remove<T>(entity);
+#else
+        if constexpr (std::is_empty_v<T>) {
+            assert(hasComponent<T>(entity) && "Removing non-existent component.");
+        } else {
+            getComponentArray<T>().removeData(entity);
+        }
+#endif
 
-        auto signature = signatures[entity];
-        signature.set(getComponentTypeId<T>(), false);
-        signatures[entity] = signature;
+        signatures[entityIndex(entity)].set(getComponentTypeId<T>(), false);
+        changes.mark(getComponentTypeId<T>(), entity);
     }
 
+    // Mutable access; marks the component changed if it is tracked
     template<typename T>
     T& getComponent(EntityId entity) {
-        return getComponentArray<T>()->getData(entity);
+        changes.mark(getComponentTypeId<T>(), entity);
+        return componentRef<T>(entity);
+    }
+
+    // Read-only access that leaves change tracking alone
+    template<typename T>
+    const T& readComponent(EntityId entity) {
+        return componentRef<T>(entity);
     }
     
     template<typename T>
     bool hasComponent(EntityId entity) {
-        return getComponentArray<T>()->hasData(entity);
+#ifdef ENGINE_ECS_ARCHETYPES
+        return archetypes.has<T>(entity);
+#else
+        if constexpr (std::is_empty_v<T>) {
+            return isAlive(entity) && signatures[entityIndex(entity)].test(getComponentTypeId<T>());
+        } else {
+            return getComponentArray<T>().hasData(entity);
+        }
+#endif
+    }
+
+    // Query all entities that have every component in Ts...
+    template<typename... Ts>
+    auto view() {
+        static_assert(sizeof...(Ts) > 0, "View needs at least one component type.");
+#ifdef ENGINE_ECS_ARCHETYPES
+        return ArchetypeView<Ts...>(archetypes, changes);
+#else
+        return View<Ts...>(entities, signatures, changes, dataPool<std::remove_const_t<Ts>>()...);
+#endif
     }
 
     // Get entity signature (bitset of components)
-    const std::bitset<MAX_COMPONENTS>& getSignature(EntityId entity) const {
-        return signatures[entity];
+    const Signature& getSignature(EntityId entity) const {
+        return signatures[entityIndex(entity)];
+    }
+
+    uint32_t getLivingEntityCount() const { return livingEntityCount; }
+
+    // Change tracking, opt-in per component type. Adding or removing a
+    // tracked component, getComponent() and non-const views stamp it with the
+    // current change tick; readComponent() and view<const T>() do not.
+    template<typename T>
+    void enableChangeTracking() {
+        ComponentTypeId typeId = getComponentTypeId<T>();
+        assert(registeredComponents.test(typeId) && "Component not registered before use.");
+        changes.tracked.set(typeId);
+        changes.ticks[typeId].resize(entities.size(), 0);
     }
 
+    bool isChangeTracked(ComponentTypeId typeId) const { return changes.tracked.test(typeId); }
+
+    uint32_t getChangeTick() const { return changes.tick; }
+
+    // Starts a new change tick. Consumers remember the tick they last looked
+    // at and treat stamps after it as changed.
+    uint32_t advanceChangeTick() { return ++changes.tick; }
+
+    // Tick a tracked component of the entity at index last changed at, or 0
+    uint32_t getChangedTick(ComponentTypeId typeId, uint32_t index) const {
+        assert(changes.tracked.test(typeId) && "Component is not change tracked.");
+        return changes.ticks[typeId][index];
+    }
+
+    // Includes T in getStateHash() and turns on change tracking for it. The
+    // hash reads T's bytes, so components must not carry garbage padding.
+    template<typename T>
+    void enableStateHash() {
+        static_assert(std::is_trivially_copyable_v<T>, "State hashes read components bitwise.");
+        ComponentTypeId typeId = getComponentTypeId<T>();
+        enableChangeTracking<T>();
+        auto registration = std::find(registrationOrder.begin(), registrationOrder.end(), typeId);
+        stateHash.hashed.set(typeId);
+        stateHash.seeds[typeId] = static_cast<uint64_t>(registration - registrationOrder.begin())
+                                  << 32;
+        stateHash.hashers[typeId] = [](World& world, EntityId entity, uint64_t seed) -> uint64_t {
+            if constexpr (std::is_empty_v<T>) {
+                return hashBytes(nullptr, 0, seed);
+            } else {
+                return hashBytes(&world.readComponent<T>(entity), sizeof(T), seed);
+            }
+        };
+        refreshStateHash(typeId, 0, true);
+    }
+
+    // Fingerprint of every hashed component; Worlds holding the same entities
+    // and values hash the same regardless of storage order. Only entries
+    // stamped since the last call are rehashed. Call between ticks.
+    uint64_t getStateHash();
+
+    // Number of entity slots, live or free; entity indices are below this
+    uint32_t getSlotCount() const { return static_cast<uint32_t>(entities.size()); }
+
+    // Live entity occupying a slot, or INVALID_ENTITY for a free or retired slot
+    EntityId getEntityAt(uint32_t index) const {
+        bool live = index < entities.size() && entityIndex(entities[index]) == index;
+        return live ? entities[index] : INVALID_ENTITY;
+    }
+
+    // Appends a binary snapshot of every entity and component (format in Snapshot.h)
+    void saveSnapshot(std::vector<std::byte>& out) const;
+
+    // Destroys every entity and component; registrations are kept
+    void clear();
+
+    // Restores a snapshot into a fresh (or cleared) World that registered the same
+    // components in the same order. False if the data is malformed or was
+    // written with different components; the World is then left empty.
+    bool loadSnapshot(const std::byte* data, size_t size);
+
 private:
     // Entity Manager State
-    std::queue<EntityId> availableEntities;
-    std::array<std::bitset<MAX_COMPONENTS>, MAX_ENTITIES> signatures;
+    // Slot table indexed by entity index. Live slots hold their own handle;
+    // free slots form an intrusive free list: their index bits point at the
+    // next free slot and their generation is the one the slot is reused with.
+    // Slots that used up every generation hold RETIRED_SLOT and are never
+    // reused; free slots always carry a generation of at least 1.
+    static constexpr uint32_t NO_FREE_SLOT = ENTITY_INDEX_MASK;
+    static constexpr EntityId RETIRED_SLOT = makeEntityId(NO_FREE_SLOT, 0);
+    std::vector<EntityId> entities;
+    std::vector<Signature> signatures;
+    uint32_t freeListHead = NO_FREE_SLOT;
     uint32_t livingEntityCount = 0;
 
     // Component Manager State
-    std::unordered_map<const char*, std::shared_ptr<IComponentArray>> componentArrays;
-    std::unordered_map<const char*, ComponentTypeId> componentTypes;
+    // Pools are indexed directly by component type ID (null for tags)
+    std::array<std::unique_ptr<IComponentArray>, MAX_COMPONENTS> componentArrays;
+    Signature registeredComponents;
+
+    // Snapshots refer to components by registration order, since type IDs
+    // are assigned at runtime and can differ between processes
+    std::vector<ComponentTypeId> registrationOrder;
+    std::array<uint32_t, MAX_COMPONENTS> snapshotElementSizes{};
+
+    ChangeTracking changes;
+    StateHash stateHash;
+
+    // Keeps every tracked stamp vector as long as the slot table
+    void growChangeTicks();
+    // Stamps every slot of every tracked type, for wholesale state changes
+    void markAllChanged();
+    void refreshStateHash(ComponentTypeId typeId, uint32_t since, bool everything);
+
+    bool readSnapshot(SnapshotReader& reader);
+#ifdef ENGINE_ECS_ARCHETYPES
+    ArchetypeStorage archetypes;
+#endif
+
+    template<typename T>
+    T& componentRef(EntityId entity) {
+#ifdef ENGINE_ECS_ARCHETYPES
+        return archetypes.get<T>(entity);
+#else
+        if constexpr (std::is_empty_v<T>) {
+            assert(hasComponent<T>(entity) && "Retrieving non-existent component.");
+            return tagComponent<T>();
+        } else {
+            return getComponentArray<T>().getData(entity);
+        }
+#endif
+    }
+
+    // Pool pointer handed to views; tags have no pool
+    template<typename T>
+    ComponentArray<T>* dataPool() {
+        if constexpr (std::is_empty_v<T>) {
+            return nullptr;
+        } else {
+            return &getComponentArray<T>();
+        }
+    }
 
     template<typename T>
-    std::shared_ptr<ComponentArray<T>> getComponentArray() {
-        const char* typeName = typeid(T).name();
-        assert(componentTypes.find(typeName) != componentTypes.end() && "Component not registered before use.");
-        return std::static_pointer_cast<ComponentArray<T>>(componentArrays[typeName]);
+    ComponentArray<T>& getComponentArray() {
+        static_assert(!std::is_empty_v<T>, "Tag components have no component array.");
+        ComponentTypeId typeId = getComponentTypeId<T>();
+        assert(registeredComponents.test(typeId) && "Component not registered before use.");
+        return static_cast<ComponentArray<T>&>(*componentArrays[typeId]);
     }
 };
 
@@ -1,9 +1,24 @@
-
 #pragma once
-#include <GLFW/glfw3.h>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
 
+// Batched 2D shape renderer. Shapes are appended to a CPU-side vertex batch
+// with per-vertex colour and drawn in submission order by Flush().
+// Built with ENGINE_NULL_RENDERER, shapes are batched as usual but Clear()
+// and Flush() drop the batch without touching OpenGL (used by engine_bench).
 class Renderer {
 public:
+    struct Vertex {
+        float x, y;
+        uint8_t r, g, b, a;
+    };
+
+    static constexpr int CIRCLE_SEGMENTS = 32;
+    // Flush early past this many vertices to bound batch memory
+    static constexpr size_t MAX_BATCH_VERTICES = 1 << 20;
+
     Renderer();
     ~Renderer();
     
@@ -11,4 +26,24 @@ public:
     void Clear();
     void RenderRectangle(float x, float y, float width, float height, float r, float g, float b);
     void RenderCircle(float x, float y, float radius, float r, float g, float b);
+
+    // Draws everything batched since the last flush with one indexed draw call
+    void Flush();
+
+    size_t GetBatchedVertexCount() const { return vertices.size(); }
+    size_t GetBatchedIndexCount() const { return indices.size(); }
+    const std::vector<Vertex>& GetBatchedVertices() const { return vertices; }
+    const std::vector<uint32_t>& GetBatchedIndices() const { return indices; }
+
+    // Draw calls issued since the last Clear()
+    size_t GetDrawCallCount() const { return drawCalls; }
+
+private:
+    // Reserves room for a shape and returns the index of its first vertex
+    uint32_t BeginShape(size_t vertexCount);
+
+    std::vector<Vertex> vertices;
+    std::vector<uint32_t> indices;
+    size_t drawCalls = 0;
+    std::array<float, CIRCLE_SEGMENTS * 2> unitCircle; // cos/sin pairs, built once
 };
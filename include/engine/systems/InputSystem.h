@@ -3,6 +3,7 @@
 #include "game/components/GameComponents.h"
 #include "engine/core/InputRecorder.h"
 #include <GLFW/glfw3.h>
+#include <vector>
 
 namespace engine {
 
@@ -12,9 +13,27 @@ public:
     
     void update(World& world, float dt) override;
 
+    SystemAccess getAccess() const override {
+        return {Signature(), componentSignature<game::PlayerInput, game::Velocity>()};
+    }
+
+    // Polls GLFW, which must happen on the main thread
+    bool requiresMainThread() const override { return true; }
+
+    const char* getName() const override { return "InputSystem"; }
+
+    // Starts a recording requested with F5 and, while recording, stores a
+    // World keyframe every KEYFRAME_INTERVAL frames (the first at frame 0) so
+    // playback can seek. Call between ticks, when no system is running.
+    void captureKeyframe(World& world);
+
+    static constexpr uint64_t KEYFRAME_INTERVAL = 600;
+
 private:
     GLFWwindow* window;
     InputRecorder recorder;
+    bool recordingRequested = false;
+    std::vector<std::byte> keyframe;
 };
 
 } // namespace engine
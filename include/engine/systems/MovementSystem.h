@@ -1,12 +1,37 @@
 #pragma once
 #include "engine/ecs/System.h"
+#include "engine/ecs/SpatialGrid.h"
 #include "game/components/GameComponents.h"
 
 namespace engine {
 
+// Integrates Transform by Velocity and clamps it to the world bounds, saving
+// the old position to PreviousTransform when the entity has one.
 class MovementSystem : public System {
 public:
+    // With a thread pool, entities are processed in parallel slices. With a
+    // spatial grid, every Transform is re-indexed after integrating.
+    explicit MovementSystem(ThreadPool* threadPool = nullptr, SpatialGrid* spatialGrid = nullptr)
+        : threadPool(threadPool), spatialGrid(spatialGrid) {}
+
     void update(World& world, float dt) override;
+
+    SystemAccess getAccess() const override {
+        return {componentSignature<game::Velocity, game::Renderable>(),
+                componentSignature<game::Transform, game::PreviousTransform>()};
+    }
+
+    const char* getName() const override { return "MovementSystem"; }
+
+private:
+    // Simple boundary clamping (to keep entities on screen)
+    static constexpr float WORLD_SIZE = 0.9f;
+    static constexpr size_t GRAIN_SIZE = 4096;
+
+    void rebuildSpatialGrid(World& world);
+
+    ThreadPool* threadPool;
+    SpatialGrid* spatialGrid;
 };
 
 } // namespace engine
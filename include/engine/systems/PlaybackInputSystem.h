@@ -0,0 +1,41 @@
+#pragma once
+#include "engine/ecs/System.h"
+#include "engine/core/InputRecorder.h"
+#include "game/components/GameComponents.h"
+#include <string>
+
+namespace engine {
+
+// GL-free input source: feeds PlayerInput from a recording made by
+// InputSystem and converts it to Velocity exactly like the keyboard path.
+// Without a recording (or once it runs out) inputs stay as they are.
+class PlaybackInputSystem : public System {
+public:
+    PlaybackInputSystem() = default;
+    explicit PlaybackInputSystem(const std::string& recordingFile) {
+        recorder.StartPlayback(recordingFile);
+    }
+
+    void update(World& world, float dt) override;
+
+    SystemAccess getAccess() const override {
+        return {Signature(), componentSignature<game::PlayerInput, game::Velocity>()};
+    }
+
+    const char* getName() const override { return "PlaybackInputSystem"; }
+
+    bool isPlaying() const { return recorder.GetState() == InputRecorder::State::PLAYBACK; }
+
+    // Restores the latest keyframe at or before `frame` into `world` and
+    // resumes playback from it. Returns the keyframe's frame through
+    // `keyframeFrame`; the caller simulates the rest of the way. False if the
+    // recording has no usable keyframe there.
+    bool seekToKeyframe(World& world, uint64_t frame, uint64_t& keyframeFrame);
+
+    const InputRecorder& getRecorder() const { return recorder; }
+
+private:
+    InputRecorder recorder;
+};
+
+} // namespace engine
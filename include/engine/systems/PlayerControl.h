@@ -0,0 +1,46 @@
+#pragma once
+#include "engine/ecs/World.h"
+#include "game/components/GameComponents.h"
+#include <cmath>
+#include <cstring>
+
+namespace engine {
+
+// Turns one tick of player input into a velocity. Shared by the keyboard and
+// playback input systems so both drive movement identically.
+inline void applyPlayerInput(const game::PlayerInput& input, game::Velocity& velocity) {
+    float speed = 0.5f; // Units per second
+    velocity.vx = 0.0f;
+    velocity.vy = 0.0f;
+    
+    if (input.moveUp) velocity.vy += speed;
+    if (input.moveDown) velocity.vy -= speed;
+    if (input.moveLeft) velocity.vx -= speed;
+    if (input.moveRight) velocity.vx += speed;
+    
+    // Normalize diagonal movement
+    if (velocity.vx != 0.0f && velocity.vy != 0.0f) {
+        float length = sqrtf(velocity.vx * velocity.vx + velocity.vy * velocity.vy);
+        velocity.vx = (velocity.vx / length) * speed;
+        velocity.vy = (velocity.vy / length) * speed;
+    }
+}
+
+// Stores a tick's input and the velocity it implies. Each is written through
+// getComponent() only when its bytes change, so change tracking (delta
+// snapshots, the state hash) doesn't see players who keep the same input.
+inline void storePlayerInput(World& world, EntityId entity, const game::PlayerInput& input) {
+    if (std::memcmp(&world.readComponent<game::PlayerInput>(entity), &input, sizeof(input)) != 0) {
+        world.getComponent<game::PlayerInput>(entity) = input;
+    }
+    if (world.hasComponent<game::Velocity>(entity)) {
+        game::Velocity velocity{};
+        applyPlayerInput(input, velocity);
+        const auto& current = world.readComponent<game::Velocity>(entity);
+        if (std::memcmp(&current, &velocity, sizeof(velocity)) != 0) {
+            world.getComponent<game::Velocity>(entity) = velocity;
+        }
+    }
+}
+
+} // namespace engine
@@ -1,18 +1,90 @@
 #pragma once
 #include "engine/ecs/System.h"
+#include "engine/ecs/SpatialGrid.h"
 #include "game/components/GameComponents.h"
 #include "engine/platform/Renderer.h"
+#include <cstdint>
+#include <vector>
 
 namespace engine {
 
+// Draws Transform + Renderable entities in layer order. Entities are kept in
+// persistent per-layer buckets that only change when an entity starts or stops
+// rendering or switches layer, so steady-state frames neither sort nor allocate.
+// With a spatial grid, entities outside the view bounds are culled.
 class RenderSystem : public System {
 public:
-    RenderSystem(Renderer& renderer) : renderer(renderer) {}
+    RenderSystem(Renderer& renderer, const SpatialGrid* spatialGrid = nullptr)
+        : renderer(renderer), spatialGrid(spatialGrid) {}
     
     void update(World& world, float dt) override;
 
+    SystemAccess getAccess() const override {
+        return {componentSignature<game::Transform, game::PreviousTransform, game::Renderable>(),
+                Signature()};
+    }
+
+    // Issues OpenGL calls on the context's thread
+    bool requiresMainThread() const override { return true; }
+
+    const char* getName() const override { return "RenderSystem"; }
+
+    // Visible world rectangle; defaults to the clip space of the fixed pipeline
+    void setViewBounds(float minX, float minY, float maxX, float maxY) {
+        viewMinX = minX;
+        viewMinY = minY;
+        viewMaxX = maxX;
+        viewMaxY = maxY;
+    }
+
+    size_t getLayerCount() const { return layers.size(); }
+    size_t getQueuedCount() const { return queuedCount; }
+    size_t getCulledCount() const { return culledCount; }
+
+    // Visits the queue in draw order, culled entities included, as
+    // func(EntityId, int layer, float x, float y)
+    template<typename Func>
+    void forEachQueued(Func&& func) const {
+        for (const auto& bucket : layers) {
+            for (const auto& entry : bucket.entries) {
+                func(entry.entity, bucket.layer, entry.x, entry.y);
+            }
+        }
+    }
+
 private:
+    struct QueueEntry {
+        EntityId entity;
+        float x, y; // Interpolated position, refreshed every frame
+        const game::Renderable* renderable;
+    };
+
+    struct LayerBucket {
+        int layer;
+        std::vector<QueueEntry> entries;
+    };
+
+    // Where an entity index currently sits in the queue
+    struct Slot {
+        EntityId entity = INVALID_ENTITY;
+        uint32_t bucket = 0;   // Index into layers
+        uint32_t position = 0; // Index into that bucket's entries
+        uint32_t lastSeen = 0; // Frame the entity last matched the view
+        uint32_t visible = 0;  // Frame the grid last reported it on screen
+    };
+
+    void enqueue(EntityId entity, int layer);
+    void dequeue(size_t index);
+    void sweepStale();
+
     Renderer& renderer;
+    const SpatialGrid* spatialGrid;
+    float viewMinX = -1.0f, viewMinY = -1.0f, viewMaxX = 1.0f, viewMaxY = 1.0f;
+    size_t culledCount = 0;
+    std::vector<LayerBucket> layers; // Sorted by layer, lowest first
+    std::vector<Slot> slots;         // Indexed by entity index
+    size_t queuedCount = 0;
+    uint32_t frame = 0;
 };
 
 } // namespace engine
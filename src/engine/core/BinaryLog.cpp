@@ -0,0 +1,396 @@
+#include "engine/core/BinaryLog.h"
+#include <algorithm>
+#include <chrono>
+#include <mutex>
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace engine {
+
+namespace {
+
+struct SiteDefinition {
+    LogLevel level;
+    uint32_t line;
+    std::string file;
+    std::string format;
+    std::string types;
+};
+
+struct BinaryLogState {
+    std::mutex mutex; // Open/Close and site registration
+    std::vector<SiteDefinition> sites; // Site id - 1
+
+    std::byte* mapping = nullptr;
+    size_t size = 0; // Of the mapping, header included
+    std::atomic<size_t> writePosition{0};
+    std::atomic<size_t> fullAt{0}; // End of the records once one didn't fit
+    std::atomic<uint64_t> dropped{0};
+    std::chrono::steady_clock::time_point start;
+#ifdef _WIN32
+    // No mapping: records collect in memory and are written on Close()
+    std::vector<std::byte> buffer;
+    std::string path;
+#else
+    int fd = -1;
+#endif
+};
+
+BinaryLogState& state() {
+    static BinaryLogState logState;
+    return logState;
+}
+
+template<typename T>
+void writeAt(std::byte* destination, size_t offset, T value) {
+    std::memcpy(destination + offset, &value, sizeof(T));
+}
+
+template<typename T>
+T readAt(const std::byte* source, size_t offset) {
+    T value;
+    std::memcpy(&value, source + offset, sizeof(T));
+    return value;
+}
+
+// Header field offsets
+constexpr size_t HEADER_VERSION = 4;
+constexpr size_t HEADER_CAPACITY = 8;
+constexpr size_t HEADER_END = 16;
+constexpr size_t HEADER_DROPPED = 24;
+constexpr size_t HEADER_START = 32;
+
+} // namespace
+
+bool BinaryLog::Open(const std::string& path, size_t capacity) {
+    Close();
+    BinaryLogState& log = state();
+    std::lock_guard<std::mutex> lock(log.mutex);
+    size_t size = BINARY_LOG_HEADER_SIZE + capacity;
+
+#ifdef _WIN32
+    log.buffer.assign(size, std::byte{0});
+    log.path = path;
+    log.mapping = log.buffer.data();
+#else
+    int fd = ::open(path.c_str(), O_RDWR | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        Logger::Error("Failed to create binary log: ", path);
+        return false;
+    }
+    // The file starts out sparse, so unused capacity costs no disk space
+    void* mapping = MAP_FAILED;
+    if (::ftruncate(fd, static_cast<off_t>(size)) == 0) {
+        mapping = ::mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    }
+    if (mapping == MAP_FAILED) {
+        Logger::Error("Failed to map binary log: ", path);
+        ::close(fd);
+        return false;
+    }
+    log.fd = fd;
+    log.mapping = static_cast<std::byte*>(mapping);
+#endif
+
+    log.size = size;
+    log.start = std::chrono::steady_clock::now();
+    log.writePosition.store(BINARY_LOG_HEADER_SIZE, std::memory_order_relaxed);
+    log.fullAt.store(0, std::memory_order_relaxed);
+    log.dropped.store(0, std::memory_order_relaxed);
+
+    int64_t startNs = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                          std::chrono::system_clock::now().time_since_epoch())
+                          .count();
+    writeAt(log.mapping, 0, BINARY_LOG_MAGIC);
+    writeAt(log.mapping, HEADER_VERSION, BINARY_LOG_VERSION);
+    writeAt(log.mapping, HEADER_CAPACITY, static_cast<uint64_t>(capacity));
+    writeAt(log.mapping, HEADER_START, startNs);
+
+    // Sites registered by an earlier log are defined again up front
+    for (size_t i = 0; i < log.sites.size(); ++i) {
+        const SiteDefinition& site = log.sites[i];
+        WriteRecord(0, static_cast<uint16_t>(i + 1), static_cast<uint8_t>(site.level),
+                    uint8_t(0), site.line, site.file, site.format, site.types);
+    }
+    openFlag.store(true, std::memory_order_release);
+    return true;
+}
+
+void BinaryLog::Close() {
+    BinaryLogState& log = state();
+    std::lock_guard<std::mutex> lock(log.mutex);
+    if (!openFlag.load(std::memory_order_acquire)) {
+        return;
+    }
+    openFlag.store(false, std::memory_order_release);
+
+    size_t end = log.writePosition.load(std::memory_order_acquire);
+    if (end > log.size) {
+        end = log.fullAt.load(std::memory_order_relaxed);
+    }
+    writeAt(log.mapping, HEADER_END, static_cast<uint64_t>(end));
+    writeAt(log.mapping, HEADER_DROPPED, log.dropped.load(std::memory_order_relaxed));
+
+#ifdef _WIN32
+    std::ofstream file(log.path, std::ios::binary | std::ios::trunc);
+    file.write(reinterpret_cast<const char*>(log.buffer.data()),
+               static_cast<std::streamsize>(end));
+    if (!file) {
+        Logger::Error("Failed to write binary log: ", log.path);
+    }
+    log.buffer.clear();
+    log.buffer.shrink_to_fit();
+#else
+    ::munmap(log.mapping, log.size);
+    if (::ftruncate(log.fd, static_cast<off_t>(end)) != 0) {
+        Logger::Warn("Failed to trim binary log to ", end, " bytes");
+    }
+    ::close(log.fd);
+    log.fd = -1;
+#endif
+    log.mapping = nullptr;
+    log.size = 0;
+}
+
+uint64_t BinaryLog::GetDroppedCount() {
+    return state().dropped.load(std::memory_order_relaxed);
+}
+
+uint16_t BinaryLog::RegisterSite(LogLevel level, const char* file, uint32_t line,
+                                 const char* format, const char* types) {
+    BinaryLogState& log = state();
+    std::lock_guard<std::mutex> lock(log.mutex);
+    if (log.sites.size() >= UINT16_MAX) {
+        return 0; // Out of ids; Write() ignores site 0
+    }
+    log.sites.push_back({level, line, file, format, types});
+    auto id = static_cast<uint16_t>(log.sites.size());
+
+    // Defined before any record of the site can be reserved
+    if (openFlag.load(std::memory_order_acquire)) {
+        const SiteDefinition& site = log.sites.back();
+        WriteRecord(0, id, static_cast<uint8_t>(level), uint8_t(0), line, site.file,
+                    site.format, site.types);
+    }
+    return id;
+}
+
+std::byte* BinaryLog::Reserve(size_t size) {
+    BinaryLogState& log = state();
+    size_t offset = log.writePosition.fetch_add(size, std::memory_order_relaxed);
+    if (offset + size > log.size) {
+        // Only the first record that doesn't fit starts inside the mapping
+        if (offset <= log.size) {
+            log.fullAt.store(offset, std::memory_order_relaxed);
+        }
+        log.dropped.fetch_add(1, std::memory_order_relaxed);
+        return nullptr;
+    }
+    return log.mapping + offset;
+}
+
+void BinaryLog::Commit(std::byte* record, size_t size) {
+    // A reader of a log that was never closed stops at the first size of 0,
+    // so the size must not land before the rest of the record
+    std::atomic_thread_fence(std::memory_order_release);
+    writeAt(record, 0, static_cast<uint32_t>(size));
+}
+
+uint64_t BinaryLog::Timestamp() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                     std::chrono::steady_clock::now() - state().start)
+                                     .count());
+}
+
+bool BinaryLogReader::Open(const std::string& path) {
+    sites.clear();
+    position = 0;
+    end = 0;
+    closed = false;
+    corrupt = false;
+    if (!file.open(path) || file.size() < BINARY_LOG_HEADER_SIZE) {
+        return false;
+    }
+    const std::byte* data = file.data();
+    if (readAt<uint32_t>(data, 0) != BINARY_LOG_MAGIC ||
+        readAt<uint16_t>(data, HEADER_VERSION) != BINARY_LOG_VERSION) {
+        return false;
+    }
+
+    uint64_t capacity = readAt<uint64_t>(data, HEADER_CAPACITY);
+    uint64_t recordsEnd = readAt<uint64_t>(data, HEADER_END);
+    dropped = readAt<uint64_t>(data, HEADER_DROPPED);
+    startNs = readAt<int64_t>(data, HEADER_START);
+    closed = recordsEnd != 0;
+    if (closed) {
+        if (recordsEnd < BINARY_LOG_HEADER_SIZE || recordsEnd > file.size()) {
+            return false;
+        }
+        end = static_cast<size_t>(recordsEnd);
+    } else {
+        end = static_cast<size_t>(
+            std::min<uint64_t>(file.size(), BINARY_LOG_HEADER_SIZE + capacity));
+    }
+    position = BINARY_LOG_HEADER_SIZE;
+    return true;
+}
+
+bool BinaryLogReader::Next(BinaryLogEvent& event) {
+    const std::byte* data = file.data();
+    while (!corrupt && end - position >= BINARY_LOG_RECORD_HEADER_SIZE) {
+        uint32_t size = readAt<uint32_t>(data, position);
+        if (size == 0 && !closed) {
+            return false; // Where the writer stopped
+        }
+        if (size < BINARY_LOG_RECORD_HEADER_SIZE || size > end - position) {
+            corrupt = true;
+            return false;
+        }
+        uint16_t siteId = readAt<uint16_t>(data, position + 4);
+        uint64_t timestamp = readAt<uint64_t>(data, position + 8);
+        const std::byte* payload = data + position + BINARY_LOG_RECORD_HEADER_SIZE;
+        size_t payloadSize = size - BINARY_LOG_RECORD_HEADER_SIZE;
+        position += size;
+
+        if (siteId == 0) {
+            corrupt = !ReadSite(payload, payloadSize);
+            continue;
+        }
+        if (siteId >= sites.size() || !sites[siteId].defined) {
+            corrupt = true;
+            return false;
+        }
+        const Site& site = sites[siteId];
+        if (!Format(site, payload, payloadSize, event.text)) {
+            corrupt = true;
+            return false;
+        }
+        event.timestampNs = startNs + static_cast<int64_t>(timestamp);
+        event.level = site.level;
+        event.file = site.file;
+        event.line = site.line;
+        return true;
+    }
+    if (closed && position != end) {
+        corrupt = true;
+    }
+    return false;
+}
+
+bool BinaryLogReader::ReadSite(const std::byte* payload, size_t size) {
+    if (size < 8) {
+        return false;
+    }
+    uint16_t id = readAt<uint16_t>(payload, 0);
+    uint8_t level = readAt<uint8_t>(payload, 2);
+    if (id == 0 || level > static_cast<uint8_t>(LogLevel::ERROR)) {
+        return false;
+    }
+    Site site;
+    site.level = static_cast<LogLevel>(level);
+    site.line = readAt<uint32_t>(payload, 4);
+
+    size_t offset = 8;
+    for (std::string_view* text : {&site.file, &site.format, &site.types}) {
+        if (size - offset < sizeof(uint16_t)) {
+            return false;
+        }
+        uint16_t length = readAt<uint16_t>(payload, offset);
+        offset += sizeof(uint16_t);
+        if (size - offset < length) {
+            return false;
+        }
+        *text = std::string_view(reinterpret_cast<const char*>(payload + offset), length);
+        offset += length;
+    }
+    if (offset != size) {
+        return false;
+    }
+    site.defined = true;
+    if (sites.size() <= id) {
+        sites.resize(id + size_t(1));
+    }
+    sites[id] = site;
+    return true;
+}
+
+bool BinaryLogReader::Format(const Site& site, const std::byte* payload, size_t size,
+                             std::string& text) {
+    // Arguments are formatted the same way Logger formats them
+    LogMessage message;
+    size_t offset = 0;
+    auto formatArg = [&](char type) {
+        auto put = [&](auto value) {
+            if (size - offset < sizeof(value)) {
+                return false;
+            }
+            std::memcpy(&value, payload + offset, sizeof(value));
+            offset += sizeof(value);
+            Logger::FormatTo(message, value);
+            return true;
+        };
+        switch (type) {
+            case '?': return put(bool());
+            case 'c': return put(char());
+            case 'b': return put(int8_t());
+            case 'B': return put(uint8_t());
+            case 'h': return put(int16_t());
+            case 'H': return put(uint16_t());
+            case 'i': return put(int32_t());
+            case 'I': return put(uint32_t());
+            case 'q': return put(int64_t());
+            case 'Q': return put(uint64_t());
+            case 'f': return put(float());
+            case 'd': return put(double());
+            case 's': {
+                if (size - offset < sizeof(uint16_t)) {
+                    return false;
+                }
+                uint16_t length = readAt<uint16_t>(payload, offset);
+                offset += sizeof(uint16_t);
+                if (size - offset < length) {
+                    return false;
+                }
+                message.append(reinterpret_cast<const char*>(payload + offset), length);
+                offset += length;
+                return true;
+            }
+            default: return false;
+        }
+    };
+
+    // Each "{}" takes the next argument; any left over are appended
+    std::string_view format = site.format;
+    size_t argument = 0;
+    while (argument < site.types.size()) {
+        size_t at = format.find("{}");
+        if (at == std::string_view::npos) {
+            break;
+        }
+        message.append(format.substr(0, at));
+        if (!formatArg(site.types[argument++])) {
+            return false;
+        }
+        format.remove_prefix(at + 2);
+    }
+    message.append(format);
+    for (; argument < site.types.size(); ++argument) {
+        message.append(' ');
+        if (!formatArg(site.types[argument])) {
+            return false;
+        }
+    }
+    if (offset != size) {
+        return false;
+    }
+    text.assign(message.view());
+    return true;
+}
+
+} // namespace engine
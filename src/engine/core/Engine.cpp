@@ -21,19 +21,13 @@ Engine::Engine(int width, int height, const std::string& title)
 }
 
 void Engine::InitECS() {
-    // Register all component types
-    world.registerComponent<game::Transform>();
-    world.registerComponent<game::PreviousTransform>();
-    world.registerComponent<game::Renderable>();
-    world.registerComponent<game::Velocity>();
-    world.registerComponent<game::PlayerInput>();
-    world.registerComponent<game::Player>();
-    world.registerComponent<game::Enemy>();
-    
-    // Add systems (order matters!)
-    systems.push_back(std::make_unique<engine::InputSystem>(window));
-    systems.push_back(std::make_unique<engine::MovementSystem>());
-    systems.push_back(std::make_unique<engine::RenderSystem>(renderer));
+    // Components are registered by Simulation. Add systems (registration
+    // order decides conflicting accesses)
+    inputSystem = &static_cast<engine::InputSystem&>(
+        simulation.addSystem(std::make_unique<engine::InputSystem>(window)));
+    simulation.addSystem(std::make_unique<engine::MovementSystem>(
+        &simulation.getThreadPool(), &simulation.getSpatialGrid()));
+    renderSystem = std::make_unique<engine::RenderSystem>(renderer, &simulation.getSpatialGrid());
 }
 
 void Engine::CreateTestEntities() {
@@ -90,16 +84,26 @@ void Engine::MainLoop() {
 
         accumulator += frameTime;
 
-        while (accumulator >= FIXED_TIMESTEP) {
-            Update(FIXED_TIMESTEP);
-            accumulator -= FIXED_TIMESTEP;
+        {
+            engine::ProfileScope scope(&profiler, fixedStepSection);
+            while (accumulator >= FIXED_TIMESTEP) {
+                Update(FIXED_TIMESTEP);
+                accumulator -= FIXED_TIMESTEP;
+            }
         }
 
         // Calculate alpha for interpolation
         float alpha = accumulator / FIXED_TIMESTEP;
-        Render(alpha);
-        glfwSwapBuffers(window);
+        {
+            engine::ProfileScope scope(&profiler, renderSection);
+            Render(alpha);
+        }
+        {
+            engine::ProfileScope scope(&profiler, swapSection);
+            glfwSwapBuffers(window);
+        }
         glfwPollEvents();
+        HandleProfilerKeys();
 
         // FPS Counter
         frameCount++;
@@ -107,12 +111,32 @@ void Engine::MainLoop() {
         if (fpsTimer >= 1.0f) {
             std::string newTitle = title + " - " + std::to_string(frameCount) + " FPS";
             glfwSetWindowTitle(window, newTitle.c_str());
+            if (profiler.isEnabled()) {
+                profiler.logStats();
+            }
             frameCount = 0;
             fpsTimer = 0.0f;
         }
     }
 }
 
+void Engine::HandleProfilerKeys() {
+    if (glfwGetKey(window, GLFW_KEY_F3) == GLFW_PRESS && !profiler.isEnabled()) {
+        profiler.collect(); // Drop timings from before
+        profiler.startTrace();
+        profiler.setEnabled(true);
+        engine::Logger::Info("STARTED PROFILING");
+    }
+    if (glfwGetKey(window, GLFW_KEY_F4) == GLFW_PRESS && profiler.isEnabled()) {
+        profiler.setEnabled(false);
+        if (profiler.writeTrace("trace.json")) {
+            engine::Logger::Info("STOPPED PROFILING. Trace saved to trace.json");
+        } else {
+            engine::Logger::Error("Failed to write trace.json");
+        }
+    }
+}
+
 void Engine::Update(float dt) {
     if (window) {
         if (glfwGetKey(window, GLFW_KEY_ESCAPE) == GLFW_PRESS) {
@@ -120,22 +144,13 @@ void Engine::Update(float dt) {
         }
     }
     
-    // Run ECS systems (except render system)
-    for (auto& system : systems) {
-        // Skip render system here (it runs in Render())
-        if (dynamic_cast<engine::RenderSystem*>(system.get()) == nullptr) {
-            system->update(world, dt);
-        }
-    }
+    // Run ECS systems; non-conflicting ones execute in parallel
+    inputSystem->captureKeyframe(world);
+    simulation.update(dt);
 }
 
 void Engine::Render(float alpha) {
-    // Run only the render system
-    for (auto& system : systems) {
-        if (dynamic_cast<engine::RenderSystem*>(system.get()) != nullptr) {
-            system->update(world, alpha);
-        }
-    }
+    renderSystem->update(world, alpha);
 }
 
 void Engine::Run() {
@@ -1,72 +1,186 @@
 #include "engine/core/InputRecorder.h"
 #include "engine/core/Logger.h"
-#include <fstream>
+#include <algorithm>
 
 namespace engine {
 
-InputRecorder::InputRecorder() : state(State::IDLE), currentFrame(0) {}
+namespace {
+
+constexpr uint8_t RUN_FLAG = 0x80;
+constexpr uint8_t INPUT_BITS = 0x3F;
+constexpr uint8_t KEYFRAME_MARKER = 0x40;
+constexpr size_t FRAME_COUNT_OFFSET = 12;
+constexpr size_t TRAILER_SIZE = 12;
+constexpr size_t INDEX_ENTRY_SIZE = 16;
+constexpr size_t KEYFRAME_ENTRY_SIZE = 24;
+
+template<typename T>
+void storeLittleEndian(uint8_t* out, T value) {
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        out[i] = static_cast<uint8_t>(value >> (8 * i));
+    }
+}
+
+template<typename T>
+T loadLittleEndian(const uint8_t* in) {
+    T value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<T>(in[i]) << (8 * i);
+    }
+    return value;
+}
+
+template<typename T>
+T loadLittleEndian(const std::byte* in) {
+    return loadLittleEndian<T>(reinterpret_cast<const uint8_t*>(in));
+}
+
+} // namespace
+
+InputRecorder::InputRecorder()
+    : state(State::IDLE), tickRate(0), entity(INVALID_ENTITY), frameCount(0), currentFrame(0),
+      runInput(0), runLength(0), blockPosition(0), fileOffset(0), readPosition(0), bodyEnd(0),
+      indexOffset(0), indexCount(0), keyframeOffset(0), keyframeCount(0) {}
+
+InputRecorder::~InputRecorder() {
+    StopRecording();
+}
+
+uint8_t InputRecorder::PackInput(const game::PlayerInput& input) {
+    return static_cast<uint8_t>(input.moveUp << 0 | input.moveDown << 1 | input.moveLeft << 2 |
+                                input.moveRight << 3 | input.attack << 4 | input.dodge << 5);
+}
+
+game::PlayerInput InputRecorder::UnpackInput(uint8_t bits) {
+    game::PlayerInput input;
+    input.moveUp = bits & (1 << 0);
+    input.moveDown = bits & (1 << 1);
+    input.moveLeft = bits & (1 << 2);
+    input.moveRight = bits & (1 << 3);
+    input.attack = bits & (1 << 4);
+    input.dodge = bits & (1 << 5);
+    return input;
+}
+
+void InputRecorder::StartRecording(const std::string& file, uint16_t rate, EntityId recorded) {
+    if (state != State::IDLE) return;
+
+    outFile.open(file, std::ios::binary | std::ios::trunc);
+    if (!outFile) {
+        Logger::Error("Failed to open file for recording: ", file);
+        outFile.clear();
+        return;
+    }
 
-void InputRecorder::StartRecording() {
     state = State::RECORDING;
-    frames.clear();
+    filename = file;
+    tickRate = rate;
+    entity = recorded;
+    frameCount = 0;
     currentFrame = 0;
-    Logger::Info("STARTED RECORDING input...");
+    runLength = 0;
+    blockPosition = 0;
+    fileOffset = 0;
+    index.clear();
+    keyframes.clear();
+
+    // Frame count stays 0 until StopRecording() patches it
+    uint8_t header[INPUT_RECORDING_HEADER_SIZE] = {};
+    storeLittleEndian(header + 0, INPUT_RECORDING_MAGIC);
+    storeLittleEndian(header + 4, INPUT_RECORDING_VERSION);
+    storeLittleEndian(header + 6, rate);
+    storeLittleEndian(header + 8, recorded);
+    WriteBytes(header, sizeof(header));
+    Logger::Info("STARTED RECORDING input to ", file);
 }
 
-void InputRecorder::StopRecording(const std::string& filename) {
+void InputRecorder::StopRecording() {
     if (state != State::RECORDING) return;
 
     state = State::IDLE;
-    
-    std::ofstream outFile(filename, std::ios::binary);
+    WriteRun();
+    WriteFooter();
+    FlushBlock();
+
+    uint8_t count[sizeof(uint64_t)];
+    storeLittleEndian(count, frameCount);
+    outFile.seekp(FRAME_COUNT_OFFSET);
+    outFile.write(reinterpret_cast<const char*>(count), sizeof(count));
+    outFile.close();
+
+    index.clear();
+    index.shrink_to_fit();
+    keyframes.clear();
+    keyframes.shrink_to_fit();
+
     if (!outFile) {
-        Logger::Error("Failed to open file for recording: ", filename);
+        Logger::Error("Failed to write recording: ", filename);
+        outFile.clear();
         return;
     }
-
-    // Write number of frames
-    size_t count = frames.size();
-    outFile.write(reinterpret_cast<const char*>(&count), sizeof(count));
-
-    // Write data
-    outFile.write(reinterpret_cast<const char*>(frames.data()), frames.size() * sizeof(game::PlayerInput));
-    
-    Logger::Info("STOPPED RECORDING. Saved ", count, " frames to ", filename);
+    Logger::Info("STOPPED RECORDING. Saved ", frameCount, " frames to ", filename);
 }
 
-void InputRecorder::StartPlayback(const std::string& filename) {
-    std::ifstream inFile(filename, std::ios::binary);
-    if (!inFile) {
-        Logger::Error("Failed to open file for playback: ", filename);
+void InputRecorder::StartPlayback(const std::string& file) {
+    if (state != State::IDLE) return;
+
+    if (!mappedFile.open(file)) {
+        Logger::Error("Failed to open file for playback: ", file);
         return;
     }
 
-    // Read number of frames
-    size_t count = 0;
-    inFile.read(reinterpret_cast<char*>(&count), sizeof(count));
-
-    frames.resize(count);
-    inFile.read(reinterpret_cast<char*>(frames.data()), count * sizeof(game::PlayerInput));
+    const std::byte* header = mappedFile.data();
+    if (mappedFile.size() < INPUT_RECORDING_HEADER_SIZE ||
+        loadLittleEndian<uint32_t>(header + 0) != INPUT_RECORDING_MAGIC ||
+        loadLittleEndian<uint16_t>(header + 4) != INPUT_RECORDING_VERSION) {
+        Logger::Error("Not an input recording (or unsupported version): ", file);
+        mappedFile.close();
+        return;
+    }
 
     state = State::PLAYBACK;
+    filename = file;
+    tickRate = loadLittleEndian<uint16_t>(header + 6);
+    entity = loadLittleEndian<uint32_t>(header + 8);
+    frameCount = loadLittleEndian<uint64_t>(header + FRAME_COUNT_OFFSET);
     currentFrame = 0;
-    Logger::Info("STARTED PLAYBACK. Loaded ", count, " frames from ", filename);
+    runLength = 0;
+    readPosition = INPUT_RECORDING_HEADER_SIZE;
+    bodyEnd = mappedFile.size();
+    indexOffset = 0;
+    indexCount = 0;
+    keyframeOffset = 0;
+    keyframeCount = 0;
+    if (!ReadFooter() && frameCount != 0) {
+        Logger::Warn("Recording has no valid frame index, seeking disabled: ", file);
+    }
+    Logger::Info("STARTED PLAYBACK of ", frameCount, " frames from ", file);
 }
 
 void InputRecorder::StopPlayback() {
     if (state == State::PLAYBACK) {
         state = State::IDLE;
+        mappedFile.close();
         Logger::Info("STOPPED PLAYBACK.");
     }
 }
 
 bool InputRecorder::ProcessInput(game::PlayerInput& input) {
     if (state == State::RECORDING) {
-        frames.push_back(input);
+        uint8_t bits = PackInput(input);
+        if (runLength > 0 && bits != runInput) {
+            WriteRun();
+        }
+        runInput = bits;
+        runLength++;
+        frameCount++;
+        currentFrame++;
         return false; // We didn't modify the input, just recorded it
     } else if (state == State::PLAYBACK) {
-        if (currentFrame < frames.size()) {
-            input = frames[currentFrame];
+        bool finished = frameCount != 0 && currentFrame >= frameCount;
+        if (!finished && (runLength > 0 || ReadRun())) {
+            input = UnpackInput(runInput);
+            runLength--;
             currentFrame++;
             return true; // We overwrote the input
         } else {
@@ -77,4 +191,287 @@ bool InputRecorder::ProcessInput(game::PlayerInput& input) {
     return false;
 }
 
+void InputRecorder::AddKeyframe(const std::vector<std::byte>& snapshot) {
+    if (state != State::RECORDING) return;
+    if (snapshot.size() > UINT32_MAX) {
+        Logger::Warn("Keyframe too large, skipped: ", snapshot.size(), " bytes");
+        return;
+    }
+
+    // The keyframe goes between the runs before and after this frame
+    WriteRun();
+    uint8_t prefix[5];
+    prefix[0] = KEYFRAME_MARKER;
+    storeLittleEndian(prefix + 1, static_cast<uint32_t>(snapshot.size()));
+    WriteBytes(prefix, sizeof(prefix));
+    keyframes.push_back({frameCount, fileOffset, snapshot.size()});
+    WriteBytes(reinterpret_cast<const uint8_t*>(snapshot.data()), snapshot.size());
+}
+
+bool InputRecorder::SeekToFrame(uint64_t frame) {
+    if (state != State::PLAYBACK || !CanSeek() || frame > frameCount) {
+        return false;
+    }
+
+    runLength = 0;
+    if (frame == frameCount) {
+        readPosition = bodyEnd;
+        currentFrame = frame;
+        return true;
+    }
+
+    // Jump to the run holding the closest indexed frame, then walk forward
+    // less than one interval
+    uint64_t entry = frame / INPUT_RECORDING_INDEX_INTERVAL;
+    if (entry >= indexCount) {
+        return false;
+    }
+    const std::byte* entryData = mappedFile.data() + indexOffset + entry * INDEX_ENTRY_SIZE;
+    uint64_t offset = loadLittleEndian<uint64_t>(entryData);
+    uint64_t skip = loadLittleEndian<uint64_t>(entryData + 8);
+    if (offset < INPUT_RECORDING_HEADER_SIZE || offset >= bodyEnd) {
+        Logger::Error("Corrupt frame index in recording: ", filename);
+        return false;
+    }
+
+    readPosition = static_cast<size_t>(offset);
+    if (!ReadRun() || skip >= runLength) {
+        Logger::Error("Corrupt frame index in recording: ", filename);
+        runLength = 0;
+        return false;
+    }
+    runLength -= skip;
+    currentFrame = entry * INPUT_RECORDING_INDEX_INTERVAL;
+    return SkipFrames(frame - currentFrame);
+}
+
+bool InputRecorder::FindKeyframe(uint64_t frame, InputKeyframe& keyframe) const {
+    if (state != State::PLAYBACK) {
+        return false;
+    }
+
+    // Keyframes are stored in frame order: binary search for the last one <= frame
+    const std::byte* table = mappedFile.data() + keyframeOffset;
+    auto frameAt = [&](uint64_t i) {
+        return loadLittleEndian<uint64_t>(table + i * KEYFRAME_ENTRY_SIZE);
+    };
+    uint64_t low = 0;
+    uint64_t high = keyframeCount;
+    while (low < high) {
+        uint64_t middle = low + (high - low) / 2;
+        if (frameAt(middle) <= frame) {
+            low = middle + 1;
+        } else {
+            high = middle;
+        }
+    }
+    if (low == 0) {
+        return false;
+    }
+
+    const std::byte* entryData = table + (low - 1) * KEYFRAME_ENTRY_SIZE;
+    uint64_t offset = loadLittleEndian<uint64_t>(entryData + 8);
+    uint64_t size = loadLittleEndian<uint64_t>(entryData + 16);
+    if (offset > bodyEnd || size > bodyEnd - offset) {
+        Logger::Error("Corrupt keyframe table in recording: ", filename);
+        return false;
+    }
+    keyframe.frame = frameAt(low - 1);
+    keyframe.data = mappedFile.data() + offset;
+    keyframe.size = static_cast<size_t>(size);
+    return true;
+}
+
+void InputRecorder::WriteRun() {
+    if (runLength == 0) return;
+
+    // Index every interval frame that falls into this run
+    uint64_t runStart = frameCount - runLength;
+    uint64_t indexed = (runStart + INPUT_RECORDING_INDEX_INTERVAL - 1) /
+                       INPUT_RECORDING_INDEX_INTERVAL * INPUT_RECORDING_INDEX_INTERVAL;
+    for (; indexed < frameCount; indexed += INPUT_RECORDING_INDEX_INTERVAL) {
+        index.push_back({fileOffset, indexed - runStart});
+    }
+
+    if (runLength == 1) {
+        WriteByte(runInput);
+    } else {
+        WriteByte(runInput | RUN_FLAG);
+        uint64_t extra = runLength - 2;
+        do {
+            uint8_t byte = extra & 0x7F;
+            extra >>= 7;
+            WriteByte(extra != 0 ? byte | 0x80 : byte);
+        } while (extra != 0);
+    }
+    runLength = 0;
+}
+
+void InputRecorder::WriteByte(uint8_t value) {
+    block[blockPosition++] = value;
+    fileOffset++;
+    if (blockPosition == block.size()) {
+        FlushBlock();
+    }
+}
+
+void InputRecorder::WriteBytes(const uint8_t* data, size_t size) {
+    // Large writes (keyframes) bypass the block
+    if (size >= block.size()) {
+        FlushBlock();
+        outFile.write(reinterpret_cast<const char*>(data), static_cast<std::streamsize>(size));
+        fileOffset += size;
+        return;
+    }
+    for (size_t i = 0; i < size; ++i) {
+        WriteByte(data[i]);
+    }
+}
+
+void InputRecorder::FlushBlock() {
+    outFile.write(reinterpret_cast<const char*>(block.data()),
+                  static_cast<std::streamsize>(blockPosition));
+    blockPosition = 0;
+}
+
+void InputRecorder::WriteFooter() {
+    uint64_t footerOffset = fileOffset;
+    uint8_t word[KEYFRAME_ENTRY_SIZE];
+
+    storeLittleEndian(word, INPUT_RECORDING_INDEX_INTERVAL);
+    storeLittleEndian(word + 4, static_cast<uint64_t>(index.size()));
+    WriteBytes(word, 12);
+    for (const IndexEntry& entry : index) {
+        storeLittleEndian(word, entry.offset);
+        storeLittleEndian(word + 8, entry.skip);
+        WriteBytes(word, INDEX_ENTRY_SIZE);
+    }
+
+    storeLittleEndian(word, static_cast<uint64_t>(keyframes.size()));
+    WriteBytes(word, 8);
+    for (const KeyframeEntry& entry : keyframes) {
+        storeLittleEndian(word, entry.frame);
+        storeLittleEndian(word + 8, entry.offset);
+        storeLittleEndian(word + 16, entry.size);
+        WriteBytes(word, KEYFRAME_ENTRY_SIZE);
+    }
+
+    storeLittleEndian(word, footerOffset);
+    storeLittleEndian(word + 8, INPUT_RECORDING_FOOTER_MAGIC);
+    WriteBytes(word, TRAILER_SIZE);
+}
+
+bool InputRecorder::ReadFooter() {
+    const std::byte* data = mappedFile.data();
+    size_t size = mappedFile.size();
+    if (size < INPUT_RECORDING_HEADER_SIZE + TRAILER_SIZE + 20) {
+        return false;
+    }
+
+    size_t trailer = size - TRAILER_SIZE;
+    uint64_t footer = loadLittleEndian<uint64_t>(data + trailer);
+    if (loadLittleEndian<uint32_t>(data + trailer + 8) != INPUT_RECORDING_FOOTER_MAGIC ||
+        footer < INPUT_RECORDING_HEADER_SIZE || footer > trailer - 20) {
+        return false;
+    }
+
+    // Every count is checked against the bytes left before it is trusted
+    size_t position = static_cast<size_t>(footer);
+    uint64_t entries = loadLittleEndian<uint64_t>(data + position + 4);
+    uint64_t expected = (frameCount + INPUT_RECORDING_INDEX_INTERVAL - 1) /
+                        INPUT_RECORDING_INDEX_INTERVAL;
+    if (loadLittleEndian<uint32_t>(data + position) != INPUT_RECORDING_INDEX_INTERVAL ||
+        (frameCount != 0 && entries != expected) ||
+        entries > (trailer - position - 20) / INDEX_ENTRY_SIZE) {
+        return false;
+    }
+    size_t entriesOffset = position + 12;
+    position = entriesOffset + static_cast<size_t>(entries) * INDEX_ENTRY_SIZE;
+
+    uint64_t keyframeEntries = loadLittleEndian<uint64_t>(data + position);
+    if (keyframeEntries != (trailer - position - 8) / KEYFRAME_ENTRY_SIZE ||
+        (trailer - position - 8) % KEYFRAME_ENTRY_SIZE != 0) {
+        return false;
+    }
+
+    bodyEnd = static_cast<size_t>(footer);
+    indexOffset = entriesOffset;
+    indexCount = entries;
+    keyframeOffset = position + 8;
+    keyframeCount = keyframeEntries;
+    return true;
+}
+
+bool InputRecorder::ReadByte(uint8_t& value) {
+    if (readPosition >= bodyEnd) {
+        return false;
+    }
+    value = static_cast<uint8_t>(mappedFile.data()[readPosition++]);
+    return true;
+}
+
+bool InputRecorder::ReadRun() {
+    uint8_t record = 0;
+    for (;;) {
+        if (!ReadByte(record)) {
+            return false;
+        }
+        if (record != KEYFRAME_MARKER) {
+            break;
+        }
+
+        // Linear playback steps over keyframes
+        uint8_t sizeBytes[4];
+        for (uint8_t& byte : sizeBytes) {
+            if (!ReadByte(byte)) {
+                Logger::Error("Truncated input recording: ", filename);
+                return false;
+            }
+        }
+        uint32_t size = loadLittleEndian<uint32_t>(sizeBytes);
+        if (size > bodyEnd - readPosition) {
+            Logger::Error("Truncated input recording: ", filename);
+            return false;
+        }
+        readPosition += size;
+    }
+    if (record & KEYFRAME_MARKER) {
+        Logger::Error("Corrupt input recording: ", filename);
+        return false;
+    }
+
+    runInput = record & INPUT_BITS;
+    runLength = 1;
+    if (record & RUN_FLAG) {
+        uint64_t extra = 0;
+        uint8_t byte = 0;
+        for (uint32_t shift = 0; shift < 64; shift += 7) {
+            if (!ReadByte(byte)) {
+                Logger::Error("Truncated input recording: ", filename);
+                runLength = 0;
+                return false;
+            }
+            extra |= static_cast<uint64_t>(byte & 0x7F) << shift;
+            if (!(byte & 0x80)) {
+                break;
+            }
+        }
+        runLength = extra + 2;
+    }
+    return true;
+}
+
+bool InputRecorder::SkipFrames(uint64_t count) {
+    while (count > 0) {
+        if (runLength == 0 && !ReadRun()) {
+            return false;
+        }
+        uint64_t skipped = std::min(runLength, count);
+        runLength -= skipped;
+        count -= skipped;
+        currentFrame += skipped;
+    }
+    return true;
+}
+
 } // namespace engine
@@ -1,54 +1,438 @@
 #include "engine/core/Logger.h"
-#include <iostream>
+#include <algorithm>
+#include <atomic>
+#include <charconv>
 #include <chrono>
+#include <condition_variable>
+#include <cstdio>
+#include <cstring>
 #include <ctime>
-#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <thread>
 
 namespace engine {
 
-std::mutex Logger::logMutex;
-
-void Logger::Init() {
-    // Could initialize file output here if needed
-}
-
-void Logger::Log(LogLevel level, const std::string& message) {
-    std::lock_guard<std::mutex> lock(logMutex);
-
-    // Get current time
-    auto now = std::chrono::system_clock::now();
-    auto time = std::chrono::system_clock::to_time_t(now);
-    auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(now.time_since_epoch()) % 1000;
-
-    // Color codes
-    const char* colorCode = "";
-    const char* levelStr = "";
-    const char* resetCode = "\033[0m";
-
-    switch (level) {
-        case LogLevel::DEBUG:
-            colorCode = "\033[36m"; // Cyan
-            levelStr = "DEBUG";
-            break;
-        case LogLevel::INFO:
-            colorCode = "\033[32m"; // Green
-            levelStr = "INFO ";
-            break;
-        case LogLevel::WARN:
-            colorCode = "\033[33m"; // Yellow
-            levelStr = "WARN ";
-            break;
-        case LogLevel::ERROR:
-            colorCode = "\033[31m"; // Red
-            levelStr = "ERROR";
-            break;
-    }
-
-    // Format: [HH:MM:SS.ms] [LEVEL] Message
-    std::cout << "[" << std::put_time(std::localtime(&time), "%H:%M:%S") 
-              << "." << std::setfill('0') << std::setw(3) << ms.count() << "] "
-              << colorCode << "[" << levelStr << "] " << resetCode 
-              << message << std::endl;
+namespace {
+
+// Queued text beyond this is cut off so every record fits one queue cell.
+// Synchronous logging writes messages whole.
+constexpr size_t RECORD_TEXT_SIZE = 232;
+constexpr size_t WRITER_BATCH_SIZE = 256;
+
+struct LogRecord {
+    int64_t timestampNs; // system_clock, taken by the caller
+    LogLevel level;
+    uint16_t length;
+    char text[RECORD_TEXT_SIZE];
+};
+
+int64_t wallClockNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::system_clock::now().time_since_epoch())
+        .count();
+}
+
+void fillRecord(LogRecord& record, LogLevel level, std::string_view message) {
+    record.timestampNs = wallClockNs();
+    record.level = level;
+    size_t length = std::min(message.size(), RECORD_TEXT_SIZE);
+    std::memcpy(record.text, message.data(), length);
+    if (length < message.size()) {
+        std::memcpy(record.text + RECORD_TEXT_SIZE - 3, "...", 3);
+    }
+    record.length = static_cast<uint16_t>(length);
+}
+
+// Bounded multi-producer queue (Vyukov): a producer claims a cell with one
+// CAS on the enqueue counter, fills it and publishes it through the cell's
+// sequence number. The single consumer needs no atomic read-modify-write.
+class LogQueue {
+public:
+    explicit LogQueue(size_t capacity)
+        : cells(std::make_unique<Cell[]>(capacity)), mask(capacity - 1) {
+        for (size_t i = 0; i < capacity; ++i) {
+            cells[i].sequence.store(i, std::memory_order_relaxed);
+        }
+    }
+
+    bool tryPush(LogLevel level, std::string_view message) {
+        size_t position = enqueuePosition.load(std::memory_order_relaxed);
+        Cell* cell;
+        for (;;) {
+            cell = &cells[position & mask];
+            size_t sequence = cell->sequence.load(std::memory_order_acquire);
+            auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+            if (difference == 0) {
+                if (enqueuePosition.compare_exchange_weak(position, position + 1,
+                                                          std::memory_order_relaxed)) {
+                    break;
+                }
+            } else if (difference < 0) {
+                return false; // Full
+            } else {
+                position = enqueuePosition.load(std::memory_order_relaxed);
+            }
+        }
+        fillRecord(cell->record, level, message);
+        cell->sequence.store(position + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only
+    bool tryPop(LogRecord& record) {
+        Cell& cell = cells[dequeuePosition & mask];
+        if (cell.sequence.load(std::memory_order_acquire) != dequeuePosition + 1) {
+            return false;
+        }
+        record = cell.record;
+        cell.sequence.store(dequeuePosition + mask + 1, std::memory_order_release);
+        dequeuePosition++;
+        return true;
+    }
+
+private:
+    struct alignas(64) Cell {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
+    static_assert(sizeof(Cell) == 256, "Keep queue cells at four cache lines.");
+
+    std::unique_ptr<Cell[]> cells;
+    size_t mask;
+    alignas(64) std::atomic<size_t> enqueuePosition{0};
+    alignas(64) size_t dequeuePosition = 0;
+};
+
+// Turns records into text and writes them out in batches
+class LogWriter {
+public:
+    ~LogWriter() { close(); }
+
+    void configure(const LoggerConfig& config) {
+        close();
+        console = config.console;
+        colors = config.colors;
+        if (!config.filePath.empty()) {
+            file = std::fopen(config.filePath.c_str(), "a");
+            if (!file) {
+                std::fprintf(stderr, "Failed to open log file: %s\n", config.filePath.c_str());
+            }
+        }
+    }
+
+    void append(const LogRecord& record) {
+        append(record.timestampNs, record.level, std::string_view(record.text, record.length));
+    }
+
+    void append(int64_t timestampNs, LogLevel level, std::string_view text) {
+        const char* colorCode = "";
+        const char* levelStr = "";
+        switch (level) {
+            case LogLevel::DEBUG:
+                colorCode = "\033[36m"; // Cyan
+                levelStr = "DEBUG";
+                break;
+            case LogLevel::INFO:
+                colorCode = "\033[32m"; // Green
+                levelStr = "INFO ";
+                break;
+            case LogLevel::WARN:
+                colorCode = "\033[33m"; // Yellow
+                levelStr = "WARN ";
+                break;
+            case LogLevel::ERROR:
+                colorCode = "\033[31m"; // Red
+                levelStr = "ERROR";
+                break;
+        }
+
+        // Format: [HH:MM:SS.ms] [LEVEL] Message
+        char prefix[32];
+        int64_t seconds = timestampNs / 1000000000;
+        int milliseconds = static_cast<int>(timestampNs / 1000000 % 1000);
+        std::snprintf(prefix, sizeof(prefix), "[%s.%03d] ", clockText(seconds), milliseconds);
+
+        if (console) {
+            consoleBatch += prefix;
+            if (colors) {
+                consoleBatch += colorCode;
+            }
+            consoleBatch += '[';
+            consoleBatch += levelStr;
+            consoleBatch += "] ";
+            if (colors) {
+                consoleBatch += "\033[0m";
+            }
+            consoleBatch += text;
+            consoleBatch += '\n';
+        }
+        if (file) {
+            fileBatch += prefix;
+            fileBatch += '[';
+            fileBatch += levelStr;
+            fileBatch += "] ";
+            fileBatch += text;
+            fileBatch += '\n';
+        }
+    }
+
+    void flush() {
+        if (!consoleBatch.empty()) {
+            std::fwrite(consoleBatch.data(), 1, consoleBatch.size(), stdout);
+            std::fflush(stdout);
+            consoleBatch.clear();
+        }
+        if (file && !fileBatch.empty()) {
+            std::fwrite(fileBatch.data(), 1, fileBatch.size(), file);
+            std::fflush(file);
+            fileBatch.clear();
+        }
+    }
+
+private:
+    void close() {
+        flush();
+        if (file) {
+            std::fclose(file);
+            file = nullptr;
+        }
+    }
+
+    // Local wall-clock time, converted once per second
+    const char* clockText(int64_t seconds) {
+        if (seconds != cachedSecond) {
+            std::time_t time = static_cast<std::time_t>(seconds);
+            std::tm local{};
+#ifdef _WIN32
+            localtime_s(&local, &time);
+#else
+            localtime_r(&time, &local);
+#endif
+            std::strftime(cachedText, sizeof(cachedText), "%H:%M:%S", &local);
+            cachedSecond = seconds;
+        }
+        return cachedText;
+    }
+
+    bool console = true;
+    bool colors = true;
+    std::FILE* file = nullptr;
+    std::string consoleBatch;
+    std::string fileBatch;
+    int64_t cachedSecond = -1;
+    char cachedText[16] = {};
+};
+
+struct LoggerState {
+    std::mutex mutex; // Guards the writer and reconfiguration
+    LoggerConfig config;
+    LogWriter writer;
+
+    // Async mode. `running` admits producers to the queue; stop() clears it
+    // and waits for `producers` in flight before the writer's final drain,
+    // so the queue outlives every push.
+    std::unique_ptr<LogQueue> queue;
+    std::thread thread;
+    std::atomic<bool> running{false};
+    std::atomic<uint32_t> producers{0};
+    std::atomic<bool> stopping{false};
+    std::atomic<uint64_t> pushed{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<uint64_t> dropped{0};
+    std::mutex wakeMutex;
+    std::condition_variable wake;    // Writer thread: work or shutdown
+    std::condition_variable drained; // Flush(): a batch was written
+
+    ~LoggerState() { stop(); }
+
+    void writerLoop() {
+        uint64_t reportedDrops = 0; // configure() resets the count first
+        LogRecord record;
+        for (;;) {
+            bool exiting = stopping.load(std::memory_order_acquire);
+            size_t count = 0;
+            {
+                // Callers that find the queue closed write directly, under the same lock
+                std::lock_guard<std::mutex> lock(mutex);
+                while (count < WRITER_BATCH_SIZE && queue->tryPop(record)) {
+                    writer.append(record);
+                    count++;
+                }
+
+                uint64_t drops = dropped.load(std::memory_order_relaxed);
+                if (drops != reportedDrops) {
+                    writer.append(wallClockNs(), LogLevel::WARN,
+                                  "Logger dropped " + std::to_string(drops - reportedDrops) +
+                                      " records (queue full)");
+                    reportedDrops = drops;
+                }
+                writer.flush();
+            }
+
+            if (count > 0) {
+                written.fetch_add(count, std::memory_order_release);
+                std::lock_guard<std::mutex> lock(wakeMutex);
+                drained.notify_all();
+                continue;
+            }
+            if (exiting) {
+                break; // Only exits once a pass after the last push found nothing
+            }
+
+            // Producers don't signal each record; poll with a short sleep
+            std::unique_lock<std::mutex> lock(wakeMutex);
+            wake.wait_for(lock, std::chrono::milliseconds(2));
+        }
+    }
+
+    // False once stop() has begun; the caller then writes synchronously
+    bool beginPush() {
+        producers.fetch_add(1, std::memory_order_seq_cst);
+        if (running.load(std::memory_order_seq_cst)) {
+            return true;
+        }
+        endPush();
+        return false;
+    }
+
+    void endPush() { producers.fetch_sub(1, std::memory_order_release); }
+
+    void push(LogLevel level, std::string_view message) {
+        while (!queue->tryPush(level, message)) {
+            if (config.overflow == LogOverflow::DROP) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                return;
+            }
+            wake.notify_one();
+            std::this_thread::yield();
+        }
+        pushed.fetch_add(1, std::memory_order_release);
+    }
+
+    void flush() {
+        if (!running.load(std::memory_order_acquire)) {
+            std::lock_guard<std::mutex> lock(mutex);
+            writer.flush();
+            return;
+        }
+        uint64_t target = pushed.load(std::memory_order_acquire);
+        std::unique_lock<std::mutex> lock(wakeMutex);
+        wake.notify_one();
+        while (written.load(std::memory_order_acquire) < target) {
+            drained.wait_for(lock, std::chrono::milliseconds(1));
+        }
+    }
+
+    void stop() {
+        if (thread.joinable()) {
+            // Close the queue, let pushes in flight land, then drain and exit
+            running.store(false, std::memory_order_seq_cst);
+            while (producers.load(std::memory_order_acquire) != 0) {
+                std::this_thread::yield();
+            }
+            stopping.store(true, std::memory_order_release);
+            wake.notify_one();
+            thread.join();
+        }
+        queue.reset();
+    }
+
+    void configure(const LoggerConfig& newConfig) {
+        stop();
+        std::lock_guard<std::mutex> lock(mutex);
+        config = newConfig;
+        Logger::SetLevel(config.level);
+        writer.configure(config);
+        pushed.store(0);
+        written.store(0);
+        dropped.store(0);
+        if (config.async) {
+            size_t capacity = 2;
+            while (capacity < config.queueCapacity) {
+                capacity *= 2;
+            }
+            queue = std::make_unique<LogQueue>(capacity);
+            stopping.store(false, std::memory_order_relaxed);
+            running.store(true, std::memory_order_release);
+            thread = std::thread([this] { writerLoop(); });
+        }
+    }
+};
+
+LoggerState& state() {
+    static LoggerState loggerState;
+    return loggerState;
+}
+
+} // namespace
+
+void Logger::Init(const LoggerConfig& config) {
+    state().configure(config);
+}
+
+void Logger::Shutdown() {
+    state().configure(LoggerConfig());
+}
+
+void Logger::Flush() {
+    state().flush();
+}
+
+uint64_t Logger::GetDroppedCount() {
+    return state().dropped.load(std::memory_order_relaxed);
+}
+
+void Logger::Log(LogLevel level, std::string_view message) {
+    if (!IsEnabled(level)) {
+        return;
+    }
+
+    LoggerState& logger = state();
+    if (logger.running.load(std::memory_order_acquire) && logger.beginPush()) {
+        logger.push(level, message);
+        logger.endPush();
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(logger.mutex);
+    logger.writer.append(wallClockNs(), level, message);
+    logger.writer.flush();
+}
+
+void Logger::AppendSigned(LogMessage& message, long long value) {
+    char text[24];
+    auto result = std::to_chars(text, text + sizeof(text), value);
+    message.append(text, static_cast<size_t>(result.ptr - text));
+}
+
+void Logger::AppendUnsigned(LogMessage& message, unsigned long long value) {
+    char text[24];
+    auto result = std::to_chars(text, text + sizeof(text), value);
+    message.append(text, static_cast<size_t>(result.ptr - text));
+}
+
+void Logger::AppendFloat(LogMessage& message, double value) {
+    // Same as printf's %g, which is what streams print by default
+    char text[32];
+#ifdef __cpp_lib_to_chars
+    auto result = std::to_chars(text, text + sizeof(text), value, std::chars_format::general, 6);
+    message.append(text, static_cast<size_t>(result.ptr - text));
+#else
+    int length = std::snprintf(text, sizeof(text), "%g", value);
+    message.append(text, static_cast<size_t>(length));
+#endif
+}
+
+void Logger::AppendPointer(LogMessage& message, const void* value) {
+    if (!value) {
+        message.append('0');
+        return;
+    }
+    char text[24];
+    int length = std::snprintf(text, sizeof(text), "0x%llx",
+                               static_cast<unsigned long long>(reinterpret_cast<uintptr_t>(value)));
+    message.append(text, static_cast<size_t>(length));
 }
 
 } // namespace engine
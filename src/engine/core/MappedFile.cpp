@@ -0,0 +1,90 @@
+#include "engine/core/MappedFile.h"
+
+#ifdef _WIN32
+#include <fstream>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace engine {
+
+MappedFile::~MappedFile() {
+    close();
+}
+
+#ifdef _WIN32
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    std::ifstream file(path, std::ios::binary | std::ios::ate);
+    if (!file) {
+        return false;
+    }
+    buffer.resize(static_cast<size_t>(file.tellg()));
+    file.seekg(0);
+    if (!file.read(reinterpret_cast<char*>(buffer.data()),
+                   static_cast<std::streamsize>(buffer.size()))) {
+        buffer.clear();
+        return false;
+    }
+    bytes = buffer.data();
+    length = buffer.size();
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+    buffer.clear();
+    buffer.shrink_to_fit();
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#else
+
+bool MappedFile::open(const std::string& path) {
+    close();
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        return false;
+    }
+    struct stat info;
+    if (::fstat(fd, &info) != 0) {
+        ::close(fd);
+        return false;
+    }
+
+    // mmap rejects empty ranges; an empty file is still a valid open file
+    length = static_cast<size_t>(info.st_size);
+    if (length > 0) {
+        void* mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+        if (mapping == MAP_FAILED) {
+            ::close(fd);
+            length = 0;
+            return false;
+        }
+        // Replays are read front to back, apart from seeks
+        ::madvise(mapping, length, MADV_SEQUENTIAL);
+        bytes = static_cast<const std::byte*>(mapping);
+    }
+    ::close(fd); // The mapping keeps the file alive
+    opened = true;
+    return true;
+}
+
+void MappedFile::close() {
+    if (bytes) {
+        ::munmap(const_cast<std::byte*>(bytes), length);
+    }
+    bytes = nullptr;
+    length = 0;
+    opened = false;
+}
+
+#endif
+
+} // namespace engine
@@ -0,0 +1,174 @@
+#include "engine/core/Profiler.h"
+#include "engine/core/Logger.h"
+#include <algorithm>
+#include <cstdio>
+
+namespace engine {
+
+namespace {
+
+// Small per-thread number for trace events, in order of first use
+uint32_t currentThreadIndex() {
+    static std::atomic<uint32_t> nextIndex{0};
+    thread_local uint32_t index = nextIndex.fetch_add(1, std::memory_order_relaxed);
+    return index;
+}
+
+void writeJsonString(std::FILE* file, const std::string& text) {
+    std::fputc('"', file);
+    for (char c : text) {
+        if (c == '"' || c == '\\') {
+            std::fputc('\\', file);
+            std::fputc(c, file);
+        } else if (static_cast<unsigned char>(c) < 0x20) {
+            std::fprintf(file, "\\u%04x", c);
+        } else {
+            std::fputc(c, file);
+        }
+    }
+    std::fputc('"', file);
+}
+
+// splitmix64
+uint64_t nextRandom(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+} // namespace
+
+Profiler::Profiler() : origin(std::chrono::steady_clock::now()) {}
+
+uint32_t Profiler::addSection(const std::string& name) {
+    std::lock_guard<std::mutex> lock(mutex);
+    for (size_t i = 0; i < sections.size(); ++i) {
+        if (sections[i].name == name) {
+            return static_cast<uint32_t>(i);
+        }
+    }
+    sections.push_back({name, {}, 0, 0, 0, 0});
+    return static_cast<uint32_t>(sections.size() - 1);
+}
+
+void Profiler::record(uint32_t section, int64_t startNs, int64_t endNs) {
+    uint32_t thread = currentThreadIndex();
+    int64_t durationNs = endNs - startNs;
+    std::lock_guard<std::mutex> lock(mutex);
+    Section& entry = sections[section];
+    entry.minNs = entry.count == 0 ? durationNs : std::min(entry.minNs, durationNs);
+    entry.maxNs = entry.count == 0 ? durationNs : std::max(entry.maxNs, durationNs);
+    entry.totalNs += durationNs;
+    entry.count++;
+    if (entry.samples.size() < MAX_SAMPLES) {
+        entry.samples.push_back(durationNs);
+    } else {
+        // Reservoir sampling (Algorithm R): every sample so far is kept with
+        // equal probability, so p99 stays unbiased however long collect() waits
+        uint64_t slot = nextRandom(reservoirState) % entry.count;
+        if (slot < MAX_SAMPLES) {
+            entry.samples[slot] = durationNs;
+        }
+    }
+    if (traceLimit > 0) {
+        if (trace.size() < traceLimit) {
+            trace.push_back({section, thread, startNs, endNs - startNs});
+        } else {
+            droppedEvents++;
+        }
+    }
+}
+
+std::vector<ProfileStats> Profiler::collect() {
+    std::vector<ProfileStats> stats;
+    std::lock_guard<std::mutex> lock(mutex);
+    for (Section& section : sections) {
+        std::vector<int64_t>& samples = section.samples;
+        if (section.count == 0) {
+            continue;
+        }
+        // Nearest rank: the smallest sample that at least 99% are at or below
+        size_t rank = (samples.size() * 99 + 99) / 100 - 1;
+        std::nth_element(samples.begin(), samples.begin() + rank, samples.end());
+
+        ProfileStats entry;
+        entry.name = section.name;
+        entry.count = static_cast<uint32_t>(section.count);
+        entry.minMs = section.minNs / 1e6;
+        entry.avgMs = static_cast<double>(section.totalNs) / section.count / 1e6;
+        entry.p99Ms = samples[rank] / 1e6;
+        entry.maxMs = section.maxNs / 1e6;
+        stats.push_back(std::move(entry));
+        samples.clear();
+        section.count = 0;
+        section.totalNs = 0;
+    }
+    return stats;
+}
+
+void Profiler::logStats() {
+    for (const ProfileStats& entry : collect()) {
+        char line[160];
+        std::snprintf(line, sizeof(line),
+                      "%-20s %6u calls  min %8.3f  avg %8.3f  p99 %8.3f  max %8.3f ms",
+                      entry.name.c_str(), entry.count, entry.minMs, entry.avgMs, entry.p99Ms,
+                      entry.maxMs);
+        Logger::Info(line);
+    }
+}
+
+void Profiler::startTrace(size_t maxEvents) {
+    std::lock_guard<std::mutex> lock(mutex);
+    trace.clear();
+    trace.reserve(std::min<size_t>(maxEvents, 65536));
+    traceLimit = std::max<size_t>(maxEvents, 1);
+    droppedEvents = 0;
+}
+
+bool Profiler::isTracing() const {
+    std::lock_guard<std::mutex> lock(mutex);
+    return traceLimit > 0;
+}
+
+bool Profiler::writeTrace(const std::string& path) {
+    std::vector<TraceEvent> events;
+    std::vector<std::string> names;
+    size_t dropped = 0;
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        events.swap(trace);
+        traceLimit = 0;
+        dropped = droppedEvents;
+        for (const Section& section : sections) {
+            names.push_back(section.name);
+        }
+    }
+
+    std::FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) {
+        return false;
+    }
+    // Complete ("X") events with microsecond times, one per line
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"otherData\":{\"droppedEvents\":%zu},"
+                       "\"traceEvents\":[\n", dropped);
+    uint32_t threadCount = 0;
+    for (size_t i = 0; i < events.size(); ++i) {
+        const TraceEvent& event = events[i];
+        std::fputs("{\"name\":", file);
+        writeJsonString(file, names[event.section]);
+        std::fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f},\n",
+                     event.thread, event.startNs / 1e3, event.durationNs / 1e3);
+        threadCount = std::max(threadCount, event.thread + 1);
+    }
+    for (uint32_t thread = 0; thread < threadCount; ++thread) {
+        std::fprintf(file, "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,"
+                           "\"args\":{\"name\":\"thread %u\"}},\n", thread, thread);
+    }
+    std::fputs("{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,"
+               "\"args\":{\"name\":\"engine\"}}\n]}\n", file);
+    bool ok = std::ferror(file) == 0;
+    return std::fclose(file) == 0 && ok;
+}
+
+} // namespace engine
@@ -0,0 +1,27 @@
+#include "engine/core/Simulation.h"
+#include "game/components/GameComponents.h"
+
+namespace engine {
+
+Simulation::Simulation(size_t workerCount) : threadPool(workerCount) {
+    // Register all component types
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::PreviousTransform>();
+    world.registerComponent<game::Renderable>();
+    world.registerComponent<game::Velocity>();
+    world.registerComponent<game::PlayerInput>();
+    world.registerComponent<game::Player>();
+    world.registerComponent<game::Enemy>();
+}
+
+void Simulation::enableStateHash() {
+    world.enableStateHash<game::Transform>();
+    world.enableStateHash<game::PreviousTransform>();
+    world.enableStateHash<game::Renderable>();
+    world.enableStateHash<game::Velocity>();
+    world.enableStateHash<game::PlayerInput>();
+    world.enableStateHash<game::Player>();
+    world.enableStateHash<game::Enemy>();
+}
+
+} // namespace engine
@@ -0,0 +1,129 @@
+#include "engine/core/ThreadPool.h"
+
+namespace engine {
+
+namespace {
+    // Queue owned by the current thread: 0 outside the pool, i + 1 for worker i
+    thread_local size_t currentQueue = 0;
+    thread_local const void* currentPool = nullptr;
+}
+
+ThreadPool::ThreadPool(size_t workerCount) {
+    for (size_t i = 0; i < workerCount + 1; ++i) {
+        queues.push_back(std::make_unique<TaskQueue>());
+    }
+    workers.reserve(workerCount);
+    for (size_t i = 0; i < workerCount; ++i) {
+        workers.emplace_back([this, i] { workerLoop(i + 1); });
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        stopping = true;
+    }
+    taskAvailable.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+size_t ThreadPool::defaultWorkerCount() {
+    unsigned int hardwareThreads = std::thread::hardware_concurrency();
+    return hardwareThreads > 1 ? hardwareThreads - 1 : 0;
+}
+
+void ThreadPool::submit(TaskGroup& group, std::function<void()> task) {
+    group.pending.fetch_add(1, std::memory_order_relaxed);
+
+    // Workers push onto their own deque; outside threads spread work round-robin
+    size_t queueIndex = currentQueue;
+    if (currentPool != this) {
+        queueIndex = nextQueue.fetch_add(1, std::memory_order_relaxed) % queues.size();
+    }
+
+    auto wrapped = [this, &group, task = std::move(task)] {
+        task();
+        if (group.pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            std::lock_guard<std::mutex> lock(sleepMutex);
+            groupDone.notify_all();
+        }
+    };
+
+    {
+        std::lock_guard<std::mutex> lock(queues[queueIndex]->mutex);
+        queues[queueIndex]->tasks.push_back(std::move(wrapped));
+    }
+    {
+        std::lock_guard<std::mutex> lock(sleepMutex);
+        queuedTasks.fetch_add(1, std::memory_order_release);
+    }
+    taskAvailable.notify_one();
+}
+
+void ThreadPool::wait(TaskGroup& group) {
+    size_t ownQueue = currentPool == this ? currentQueue : 0;
+    while (!group.done()) {
+        if (tryRunTask(ownQueue)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        groupDone.wait(lock, [&] {
+            return group.done() || queuedTasks.load(std::memory_order_acquire) > 0;
+        });
+    }
+}
+
+void ThreadPool::workerLoop(size_t index) {
+    currentQueue = index;
+    currentPool = this;
+
+    while (true) {
+        if (tryRunTask(index)) {
+            continue;
+        }
+        std::unique_lock<std::mutex> lock(sleepMutex);
+        taskAvailable.wait(lock, [this] {
+            return stopping || queuedTasks.load(std::memory_order_acquire) > 0;
+        });
+        if (stopping && queuedTasks.load(std::memory_order_acquire) == 0) {
+            return;
+        }
+    }
+}
+
+// Runs the newest task of the preferred queue, or steals the oldest task of
+// another one. Returns false if every queue was empty.
+bool ThreadPool::tryRunTask(size_t preferredQueue) {
+    std::function<void()> task;
+    bool found = tryPop(preferredQueue, true, task);
+    for (size_t offset = 1; !found && offset < queues.size(); ++offset) {
+        found = tryPop((preferredQueue + offset) % queues.size(), false, task);
+    }
+    if (!found) {
+        return false;
+    }
+
+    queuedTasks.fetch_sub(1, std::memory_order_acq_rel);
+    task();
+    return true;
+}
+
+bool ThreadPool::tryPop(size_t queueIndex, bool newest, std::function<void()>& task) {
+    TaskQueue& queue = *queues[queueIndex];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+    if (queue.tasks.empty()) {
+        return false;
+    }
+    if (newest) {
+        task = std::move(queue.tasks.back());
+        queue.tasks.pop_back();
+    } else {
+        task = std::move(queue.tasks.front());
+        queue.tasks.pop_front();
+    }
+    return true;
+}
+
+} // namespace engine
@@ -0,0 +1,138 @@
+#include "engine/ecs/ArchetypeStorage.h"
+#include <algorithm>
+
+namespace engine {
+
+namespace {
+    size_t alignUp(size_t value, size_t alignment) {
+        return (value + alignment - 1) / alignment * alignment;
+    }
+}
+
+void ArchetypeStorage::destroy(EntityId entity) {
+    if (find(entity)) {
+        moveEntity(entity, Signature());
+    }
+}
+
+uint32_t ArchetypeStorage::findOrCreateArchetype(const Signature& signature) {
+    auto it = archetypeLookup.find(signature);
+    if (it != archetypeLookup.end()) {
+        return it->second;
+    }
+
+    auto archetype = std::make_unique<Archetype>();
+    archetype->signature = signature;
+
+    size_t rowBytes = sizeof(EntityId);
+    for (ComponentTypeId typeId = 0; typeId < MAX_COMPONENTS; ++typeId) {
+        if (signature.test(typeId)) {
+            assert(componentInfo[typeId].registered && "Component not registered before use.");
+            archetype->types.push_back(typeId);
+            rowBytes += componentInfo[typeId].size;
+        }
+    }
+
+    // Fit as many rows as possible into one chunk, including alignment padding
+    // between columns. Rows larger than a chunk get a single-row chunk.
+    auto layoutBytes = [&](uint32_t capacity) {
+        size_t offset = sizeof(EntityId) * capacity;
+        for (ComponentTypeId typeId : archetype->types) {
+            offset = alignUp(offset, componentInfo[typeId].alignment);
+            archetype->columnOffsets[typeId] = static_cast<uint32_t>(offset);
+            offset += static_cast<size_t>(componentInfo[typeId].size) * capacity;
+        }
+        return offset;
+    };
+
+    uint32_t capacity = static_cast<uint32_t>(std::max<size_t>(ARCHETYPE_CHUNK_SIZE / rowBytes, 1));
+    while (capacity > 1 && layoutBytes(capacity) > ARCHETYPE_CHUNK_SIZE) {
+        capacity--;
+    }
+    archetype->chunkCapacity = capacity;
+    archetype->chunkBytes = std::max(layoutBytes(capacity), ARCHETYPE_CHUNK_SIZE);
+
+    uint32_t index = static_cast<uint32_t>(archetypes.size());
+    archetypes.push_back(std::move(archetype));
+    archetypeLookup.emplace(signature, index);
+    return index;
+}
+
+void ArchetypeStorage::moveEntity(EntityId entity, const Signature& signature) {
+    uint32_t index = entityIndex(entity);
+    if (index >= locations.size()) {
+        locations.resize(static_cast<size_t>(index) + 1);
+    }
+
+    // Locations are reset once an entity loses its last component, so a
+    // handle mismatch means this entity has no row yet
+    EntityLocation oldLocation;
+    if (locations[index].entity == entity) {
+        oldLocation = locations[index];
+    }
+    EntityLocation newLocation;
+
+    if (signature.any()) {
+        newLocation.entity = entity;
+        newLocation.archetype = findOrCreateArchetype(signature);
+        Archetype& target = *archetypes[newLocation.archetype];
+        newLocation.row = allocateRow(target, entity);
+
+        // Carry over every component the entity keeps
+        if (oldLocation.archetype != NO_ARCHETYPE) {
+            Archetype& source = *archetypes[oldLocation.archetype];
+            for (ComponentTypeId typeId : source.types) {
+                if (signature.test(typeId)) {
+                    std::memcpy(rowData(target, newLocation.row, typeId),
+                                rowData(source, oldLocation.row, typeId),
+                                componentInfo[typeId].size);
+                }
+            }
+        }
+    }
+
+    if (oldLocation.archetype != NO_ARCHETYPE) {
+        freeRow(*archetypes[oldLocation.archetype], oldLocation.row);
+    }
+    locations[index] = newLocation;
+}
+
+uint32_t ArchetypeStorage::allocateRow(Archetype& archetype, EntityId entity) {
+    uint32_t row = archetype.entityCount;
+    size_t chunkIndex = row / archetype.chunkCapacity;
+    if (chunkIndex == archetype.chunks.size()) {
+        ArchetypeChunk chunk;
+        chunk.memory = std::make_unique<std::byte[]>(archetype.chunkBytes);
+        archetype.chunks.push_back(std::move(chunk));
+    }
+
+    ArchetypeChunk& chunk = archetype.chunks[chunkIndex];
+    archetype.entities(chunk)[chunk.count] = entity;
+    chunk.count++;
+    archetype.entityCount++;
+    return row;
+}
+
+void ArchetypeStorage::freeRow(Archetype& archetype, uint32_t row) {
+    // Move the archetype's last row into the hole to keep chunks packed.
+    // Emptied chunks stay allocated so they can be refilled without allocating.
+    uint32_t lastRow = archetype.entityCount - 1;
+    ArchetypeChunk& lastChunk = archetype.chunks[lastRow / archetype.chunkCapacity];
+
+    if (row != lastRow) {
+        ArchetypeChunk& chunk = archetype.chunks[row / archetype.chunkCapacity];
+        EntityId movedEntity = archetype.entities(lastChunk)[lastRow % archetype.chunkCapacity];
+
+        archetype.entities(chunk)[row % archetype.chunkCapacity] = movedEntity;
+        for (ComponentTypeId typeId : archetype.types) {
+            std::memcpy(rowData(archetype, row, typeId), rowData(archetype, lastRow, typeId),
+                        componentInfo[typeId].size);
+        }
+        locations[entityIndex(movedEntity)].row = row;
+    }
+
+    lastChunk.count--;
+    archetype.entityCount--;
+}
+
+} // namespace engine
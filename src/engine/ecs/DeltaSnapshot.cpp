@@ -0,0 +1,272 @@
+#include "engine/ecs/DeltaSnapshot.h"
+#include "engine/ecs/BitStream.h"
+#include <algorithm>
+#include <cmath>
+
+namespace engine {
+
+namespace {
+
+// Record kinds, 2 bits each
+constexpr uint32_t RECORD_UPDATE = 0;
+constexpr uint32_t RECORD_CREATE = 1;
+constexpr uint32_t RECORD_DESTROY = 2;
+constexpr uint32_t RECORD_END = 3;
+
+uint32_t quantize(uint32_t bits, float precision) {
+    float value;
+    std::memcpy(&value, &bits, sizeof(value));
+    double steps = 0.0;
+    if (std::isfinite(value)) {
+        steps = std::clamp(std::nearbyint(static_cast<double>(value) / precision), -2147483648.0,
+                           2147483647.0);
+    }
+    return static_cast<uint32_t>(static_cast<int32_t>(steps));
+}
+
+uint32_t dequantize(uint32_t steps, float precision) {
+    float value = static_cast<float>(static_cast<int32_t>(steps)) * precision;
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+} // namespace
+
+void DeltaEncoder::encode(World& world, std::vector<std::byte>& out) {
+    const uint32_t fieldCount = schema.fieldCount;
+    // Slots past the World's end only exist after a clear(); they get destroys
+    uint32_t worldSlots = world.getSlotCount();
+    uint32_t slotCount = std::max(worldSlots, static_cast<uint32_t>(baseline.handles.size()));
+    baseline.resize(slotCount, fieldCount);
+
+    // With every replicated type tracked, only stamped slots need a look
+    bool tracked = hasEncoded;
+    for (const auto& component : schema.components) {
+        tracked = tracked && world.isChangeTracked(component.typeId);
+    }
+    uint32_t since = lastChangeTick;
+    lastChangeTick = world.getChangeTick();
+    world.advanceChangeTick();
+    hasEncoded = true;
+
+    BitWriter writer(out);
+    writer.writeBits(sequence++, 32);
+
+    // Slots are delta-coded; a destroy may be followed by a create in the same slot
+    uint32_t nextSlot = 0;
+    auto beginRecord = [&](uint32_t kind, uint32_t slot) {
+        writer.writeBits(kind, 2);
+        writer.writeVarUint(slot - nextSlot);
+        nextSlot = kind == RECORD_DESTROY ? slot : slot + 1;
+    };
+
+    scratch.resize(fieldCount);
+    for (uint32_t slot = 0; slot < slotCount; ++slot) {
+        if (tracked && slot < worldSlots) {
+            bool changed = false;
+            for (const auto& component : schema.components) {
+                changed = changed || world.getChangedTick(component.typeId, slot) > since;
+            }
+            if (!changed) {
+                continue;
+            }
+        }
+
+        EntityId entity = world.getEntityAt(slot);
+        Signature signature;
+        if (entity != INVALID_ENTITY) {
+            signature = world.getSignature(entity) & schema.mask;
+        }
+        bool replicated = signature.any();
+        uint32_t* known = &baseline.fields[static_cast<size_t>(slot) * fieldCount];
+
+        // The replicated entity in this slot is gone (or was recycled)
+        EntityId& handle = baseline.handles[slot];
+        if (handle != INVALID_ENTITY && (!replicated || handle != entity)) {
+            beginRecord(RECORD_DESTROY, slot);
+            handle = INVALID_ENTITY;
+            baseline.presence[slot] = 0;
+            std::fill_n(known, fieldCount, 0);
+        }
+        if (!replicated) {
+            continue;
+        }
+
+        // Current state in wire form
+        uint32_t presence = 0;
+        std::fill(scratch.begin(), scratch.end(), 0);
+        for (size_t i = 0; i < schema.components.size(); ++i) {
+            const auto& component = schema.components[i];
+            if (!signature.test(component.typeId)) {
+                continue;
+            }
+            presence |= 1u << i;
+            uint32_t* fields = &scratch[component.fieldOffset];
+            component.read(world, entity, fields);
+            for (uint32_t f = 0; f < component.fieldCount; ++f) {
+                if (component.precision[f] > 0.0f) {
+                    fields[f] = quantize(fields[f], component.precision[f]);
+                }
+            }
+        }
+
+        bool created = handle == INVALID_ENTITY;
+        if (!created && presence == baseline.presence[slot] &&
+            std::equal(scratch.begin(), scratch.end(), known)) {
+            continue;
+        }
+
+        beginRecord(created ? RECORD_CREATE : RECORD_UPDATE, slot);
+        if (created) {
+            writer.writeBits(entityGeneration(entity), ENTITY_GENERATION_BITS);
+        }
+        for (size_t i = 0; i < schema.components.size(); ++i) {
+            const auto& component = schema.components[i];
+            const uint32_t* now = &scratch[component.fieldOffset];
+            const uint32_t* before = known + component.fieldOffset;
+            bool present = presence & (1u << i);
+            bool wasPresent = baseline.presence[slot] & (1u << i);
+            bool fieldsChanged = !std::equal(now, now + component.fieldCount, before);
+
+            // Creates list every component; updates flag the touched ones
+            bool touched = created || present != wasPresent || fieldsChanged;
+            if (!created) {
+                writer.writeBool(touched);
+            }
+            if (!touched) {
+                continue;
+            }
+            writer.writeBool(present);
+            if (!present) {
+                continue;
+            }
+            for (uint32_t f = 0; f < component.fieldCount; ++f) {
+                writer.writeBool(now[f] != before[f]);
+            }
+            for (uint32_t f = 0; f < component.fieldCount; ++f) {
+                if (now[f] == before[f]) {
+                    continue;
+                }
+                if (component.precision[f] > 0.0f) {
+                    writer.writeVarInt(static_cast<int32_t>(now[f] - before[f]));
+                } else {
+                    writer.writeBits(now[f], 32);
+                }
+            }
+        }
+
+        std::copy(scratch.begin(), scratch.end(), known);
+        baseline.presence[slot] = presence;
+        handle = entity;
+    }
+    writer.writeBits(RECORD_END, 2);
+}
+
+bool DeltaDecoder::decode(World& world, const std::byte* data, size_t size) {
+    const uint32_t fieldCount = schema.fieldCount;
+    BitReader reader(data, size);
+    uint32_t messageSequence = reader.readBits(32);
+    if (reader.hasFailed() || messageSequence != sequence) {
+        return false;
+    }
+
+    uint32_t nextSlot = 0;
+    for (;;) {
+        uint32_t kind = reader.readBits(2);
+        if (kind == RECORD_END || reader.hasFailed()) {
+            break;
+        }
+        uint32_t gap = reader.readVarUint();
+        if (reader.hasFailed() || gap >= MAX_ENTITIES - nextSlot) {
+            return false;
+        }
+        uint32_t slot = nextSlot + gap;
+        nextSlot = kind == RECORD_DESTROY ? slot : slot + 1;
+        if (slot >= baseline.handles.size()) {
+            baseline.resize(slot + 1, fieldCount);
+            localHandles.resize(slot + 1, INVALID_ENTITY);
+        }
+        uint32_t* known = &baseline.fields[static_cast<size_t>(slot) * fieldCount];
+
+        if (kind == RECORD_DESTROY) {
+            if (baseline.handles[slot] == INVALID_ENTITY) {
+                return false;
+            }
+            if (world.isAlive(localHandles[slot])) {
+                world.destroyEntity(localHandles[slot]);
+            }
+            baseline.handles[slot] = INVALID_ENTITY;
+            baseline.presence[slot] = 0;
+            localHandles[slot] = INVALID_ENTITY;
+            std::fill_n(known, fieldCount, 0);
+            continue;
+        }
+
+        bool created = kind == RECORD_CREATE;
+        if (created) {
+            if (baseline.handles[slot] != INVALID_ENTITY) {
+                return false;
+            }
+            uint32_t generation = reader.readBits(ENTITY_GENERATION_BITS);
+            baseline.handles[slot] = makeEntityId(slot, generation);
+            localHandles[slot] = world.createEntity();
+        } else if (baseline.handles[slot] == INVALID_ENTITY) {
+            return false;
+        }
+        EntityId local = localHandles[slot];
+
+        for (size_t i = 0; i < schema.components.size(); ++i) {
+            const auto& component = schema.components[i];
+            if (!created && !reader.readBool()) {
+                continue;
+            }
+            bool present = reader.readBool();
+            bool wasPresent = baseline.presence[slot] & (1u << i);
+            uint32_t* fields = known + component.fieldOffset;
+            if (!present) {
+                if (wasPresent) {
+                    component.remove(world, local);
+                    baseline.presence[slot] &= ~(1u << i);
+                    std::fill_n(fields, component.fieldCount, 0);
+                }
+                continue;
+            }
+
+            uint32_t changedMask = 0;
+            for (uint32_t f = 0; f < component.fieldCount; ++f) {
+                changedMask |= static_cast<uint32_t>(reader.readBool()) << f;
+            }
+            scratch.resize(component.fieldCount);
+            for (uint32_t f = 0; f < component.fieldCount; ++f) {
+                bool quantized = component.precision[f] > 0.0f;
+                if (changedMask & (1u << f)) {
+                    fields[f] = quantized ? fields[f] + static_cast<uint32_t>(reader.readVarInt())
+                                          : reader.readBits(32);
+                }
+                scratch[f] = quantized ? dequantize(fields[f], component.precision[f]) : fields[f];
+            }
+            if (reader.hasFailed()) {
+                return false;
+            }
+            component.write(world, local, scratch.data());
+            baseline.presence[slot] |= 1u << i;
+        }
+    }
+
+    if (reader.hasFailed()) {
+        return false;
+    }
+    ++sequence;
+    return true;
+}
+
+EntityId DeltaDecoder::toLocal(EntityId remote) const {
+    uint32_t slot = entityIndex(remote);
+    if (slot >= baseline.handles.size() || baseline.handles[slot] != remote) {
+        return INVALID_ENTITY;
+    }
+    return localHandles[slot];
+}
+
+} // namespace engine
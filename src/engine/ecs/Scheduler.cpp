@@ -0,0 +1,75 @@
+#include "engine/ecs/Scheduler.h"
+#include <algorithm>
+
+namespace engine {
+
+System& Scheduler::addSystem(std::unique_ptr<System> system) {
+    if (profiler) {
+        profileSections.push_back(profiler->addSection(system->getName()));
+    }
+    systems.push_back(std::move(system));
+    stagesDirty = true;
+    return *systems.back();
+}
+
+size_t Scheduler::getStageCount() {
+    if (stagesDirty) {
+        buildStages();
+    }
+    return stages.size();
+}
+
+void Scheduler::buildStages() {
+    std::vector<SystemAccess> accesses;
+    std::vector<size_t> stageOf(systems.size(), 0);
+    accesses.reserve(systems.size());
+    stages.clear();
+
+    for (size_t i = 0; i < systems.size(); ++i) {
+        accesses.push_back(systems[i]->getAccess());
+        for (size_t j = 0; j < i; ++j) {
+            if (accesses[i].conflictsWith(accesses[j])) {
+                stageOf[i] = std::max(stageOf[i], stageOf[j] + 1);
+            }
+        }
+        if (stageOf[i] >= stages.size()) {
+            stages.resize(stageOf[i] + 1);
+        }
+        stages[stageOf[i]].push_back(i);
+    }
+    stagesDirty = false;
+}
+
+void Scheduler::update(World& world, float dt) {
+    if (stagesDirty) {
+        buildStages();
+    }
+
+    for (const auto& stage : stages) {
+        if (stage.size() == 1) {
+            runSystem(stage.front(), world, dt);
+            continue;
+        }
+
+        TaskGroup group;
+        for (size_t index : stage) {
+            if (!systems[index]->requiresMainThread()) {
+                threadPool.submit(group,
+                                  [this, index, &world, dt] { runSystem(index, world, dt); });
+            }
+        }
+        for (size_t index : stage) {
+            if (systems[index]->requiresMainThread()) {
+                runSystem(index, world, dt);
+            }
+        }
+        threadPool.wait(group);
+    }
+}
+
+void Scheduler::runSystem(size_t index, World& world, float dt) {
+    ProfileScope scope(profiler, profiler ? profileSections[index] : 0);
+    systems[index]->update(world, dt);
+}
+
+} // namespace engine
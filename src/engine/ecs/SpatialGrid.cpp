@@ -0,0 +1,106 @@
+#include "engine/ecs/SpatialGrid.h"
+#include <cassert>
+#include <cmath>
+
+namespace engine {
+
+SpatialGrid::SpatialGrid(float minX, float minY, float maxX, float maxY, float cellSize)
+    : originX(minX), originY(minY), cellSize(cellSize), inverseCellSize(1.0f / cellSize) {
+    assert(maxX > minX && maxY > minY && cellSize > 0.0f && "Invalid grid bounds.");
+    columns = std::max(1, static_cast<int>(std::ceil((maxX - minX) / cellSize)));
+    rows = std::max(1, static_cast<int>(std::ceil((maxY - minY) / cellSize)));
+    cellStart.assign(static_cast<size_t>(columns) * rows + 1, 0);
+}
+
+void SpatialGrid::clear() {
+    pending.clear();
+    pendingCell.clear();
+}
+
+void SpatialGrid::insert(EntityId entity, float x, float y,
+                         float boundsMinX, float boundsMinY, float boundsMaxX, float boundsMaxY) {
+    pending.push_back({entity, x, y, boundsMinX, boundsMinY, boundsMaxX, boundsMaxY});
+    pendingCell.push_back(static_cast<uint32_t>(cellY(y) * columns + cellX(x)));
+}
+
+void SpatialGrid::build() {
+    // Counting sort of the pending entries by cell
+    std::fill(cellStart.begin(), cellStart.end(), 0);
+    for (uint32_t cell : pendingCell) {
+        ++cellStart[cell + 1];
+    }
+    for (size_t c = 1; c < cellStart.size(); ++c) {
+        cellStart[c] += cellStart[c - 1];
+    }
+
+    std::fill(indexed.begin(), indexed.end(), INVALID_ENTITY);
+
+    entries.resize(pending.size());
+    maxExtent = 0.0f;
+    for (size_t i = 0; i < pending.size(); ++i) {
+        const Entry& entry = pending[i];
+        entries[cellStart[pendingCell[i]]++] = entry;
+
+        maxExtent = std::max({maxExtent, entry.x - entry.minX, entry.maxX - entry.x,
+                              entry.y - entry.minY, entry.maxY - entry.y});
+
+        size_t index = entityIndex(entry.entity);
+        if (index >= indexed.size()) {
+            indexed.resize(index + 1, INVALID_ENTITY);
+        }
+        indexed[index] = entry.entity;
+    }
+
+    // The scatter advanced every start to the next cell's start; shift back
+    for (size_t c = cellStart.size() - 1; c > 0; --c) {
+        cellStart[c] = cellStart[c - 1];
+    }
+    cellStart[0] = 0;
+}
+
+void SpatialGrid::queryRange(float minX, float minY, float maxX, float maxY,
+                             std::vector<EntityId>& out) const {
+    queryRange(minX, minY, maxX, maxY, [&](EntityId entity) { out.push_back(entity); });
+}
+
+EntityId SpatialGrid::nearest(float x, float y, float maxDistance) const {
+    EntityId best = INVALID_ENTITY;
+    float bestDistanceSq = maxDistance * maxDistance;
+    int centerX = cellX(x), centerY = cellY(y);
+    int maxRing = std::max(columns, rows);
+
+    // Visit rings of cells around the query cell. Everything in ring r lies
+    // at least (r - 1) cells away, so stop once that can't beat the best.
+    for (int ring = 0; ring <= maxRing; ++ring) {
+        float ringDistance = std::max(0, ring - 1) * cellSize;
+        if (ringDistance * ringDistance > bestDistanceSq) {
+            break;
+        }
+
+        for (int cy = centerY - ring; cy <= centerY + ring; ++cy) {
+            if (cy < 0 || cy >= rows) {
+                continue;
+            }
+            bool edgeRow = cy == centerY - ring || cy == centerY + ring;
+            int step = edgeRow ? 1 : std::max(1, ring * 2);
+            for (int cx = centerX - ring; cx <= centerX + ring; cx += step) {
+                if (cx < 0 || cx >= columns) {
+                    continue;
+                }
+                size_t cell = static_cast<size_t>(cy) * columns + static_cast<size_t>(cx);
+                for (uint32_t i = cellStart[cell]; i < cellStart[cell + 1]; ++i) {
+                    float dx = entries[i].x - x;
+                    float dy = entries[i].y - y;
+                    float distanceSq = dx * dx + dy * dy;
+                    if (distanceSq <= bestDistanceSq) {
+                        bestDistanceSq = distanceSq;
+                        best = entries[i].entity;
+                    }
+                }
+            }
+        }
+    }
+    return best;
+}
+
+} // namespace engine
@@ -1,40 +1,337 @@
 #include "engine/ecs/World.h"
+#include <algorithm>
 #include <cassert>
 
 namespace engine {
 
-World::World() {
-    // Initialize available entities queue
-    for (EntityId entity = 0; entity < MAX_ENTITIES; ++entity) {
-        availableEntities.push(entity);
-    }
-}
-
 EntityId World::createEntity() {
     assert(livingEntityCount < MAX_ENTITIES && "Too many entities in existence.");
 
-    EntityId id = availableEntities.front();
-    availableEntities.pop();
+    EntityId id;
+    if (freeListHead != NO_FREE_SLOT) {
+        // Pop the free list; the slot already carries its next generation
+        uint32_t index = freeListHead;
+        freeListHead = entityIndex(entities[index]);
+        id = makeEntityId(index, entityGeneration(entities[index]));
+        entities[index] = id;
+    } else {
+        assert(entities.size() < MAX_ENTITIES && "Entity slots exhausted.");
+        id = makeEntityId(static_cast<uint32_t>(entities.size()), 0);
+        entities.push_back(id);
+        signatures.emplace_back();
+        growChangeTicks();
+    }
     livingEntityCount++;
 
     return id;
 }
 
 void World::destroyEntity(EntityId entity) {
-    assert(entity < MAX_ENTITIES && "Entity out of range.");
+    assert(isAlive(entity) && "Destroying dead or stale entity.");
+    uint32_t index = entityIndex(entity);
 
-    // Invalidate signature
-    signatures[entity].reset();
+    // Remove entity's data from the component arrays it has data in
+#ifdef ENGINE_ECS_ARCHETYPES
+    archetypes.destroy(entity);
+#else
+    const Signature& signature = signatures[index];
+    for (ComponentTypeId typeId = 0; typeId < MAX_COMPONENTS; ++typeId) {
+        if (signature.test(typeId) && componentArrays[typeId]) {
+            componentArrays[typeId]->entityDestroyed(entity);
+        }
+    }
+#endif
 
-    // Remove entity's data from all component arrays
-    for (auto const& pair : componentArrays) {
-        auto const& component = pair.second;
-        component->entityDestroyed(entity);
+    // Removal counts as a change for tracked components
+    for (ComponentTypeId typeId = 0; typeId < MAX_COMPONENTS; ++typeId) {
+        if (signatures[index].test(typeId)) {
+            changes.mark(typeId, entity);
+        }
     }
 
-    // Make ID available again
-    availableEntities.push(entity);
+    // Invalidate signature
+    signatures[index].reset();
+
+    // Push the slot onto the free list with a bumped generation. Once the
+    // generation would wrap, old handles could match again: retire the slot.
+    if (entityGeneration(entity) == ENTITY_GENERATION_MASK) {
+        entities[index] = RETIRED_SLOT;
+    } else {
+        entities[index] = makeEntityId(freeListHead, entityGeneration(entity) + 1);
+        freeListHead = index;
+    }
     livingEntityCount--;
 }
 
+void World::growChangeTicks() {
+    for (ComponentTypeId typeId = 0; typeId < MAX_COMPONENTS; ++typeId) {
+        if (changes.tracked.test(typeId)) {
+            changes.ticks[typeId].resize(entities.size(), 0);
+        }
+    }
+}
+
+void World::markAllChanged() {
+    for (ComponentTypeId typeId = 0; typeId < MAX_COMPONENTS; ++typeId) {
+        if (changes.tracked.test(typeId)) {
+            std::fill(changes.ticks[typeId].begin(), changes.ticks[typeId].end(), changes.tick);
+        }
+    }
+}
+
+uint64_t World::getStateHash() {
+    uint32_t since = stateHash.lastTick;
+    stateHash.lastTick = changes.tick;
+    advanceChangeTick();
+    for (ComponentTypeId typeId = 0; typeId < MAX_COMPONENTS; ++typeId) {
+        if (stateHash.hashed.test(typeId)) {
+            refreshStateHash(typeId, since, false);
+        }
+    }
+    return stateHash.total;
+}
+
+void World::refreshStateHash(ComponentTypeId typeId, uint32_t since, bool everything) {
+    // Slots beyond the table only remain after a clear()
+    std::vector<uint64_t>& contributions = stateHash.contributions[typeId];
+    for (size_t index = entities.size(); index < contributions.size(); ++index) {
+        stateHash.total -= contributions[index];
+    }
+    contributions.resize(entities.size(), 0);
+
+    // Stamps are scanned in blocks so untouched stretches cost one
+    // vectorizable max per block
+    constexpr uint32_t BLOCK = 64;
+    const uint32_t* ticks = changes.ticks[typeId].data();
+    uint32_t slotCount = static_cast<uint32_t>(entities.size());
+    for (uint32_t begin = 0; begin < slotCount; begin += BLOCK) {
+        uint32_t end = std::min(begin + BLOCK, slotCount);
+        if (!everything) {
+            uint32_t newest = 0;
+            for (uint32_t index = begin; index < end; ++index) {
+                newest = std::max(newest, ticks[index]);
+            }
+            if (newest <= since) {
+                continue;
+            }
+        }
+
+        for (uint32_t index = begin; index < end; ++index) {
+            if (!everything && ticks[index] <= since) {
+                continue;
+            }
+            EntityId entity = entities[index];
+            uint64_t value = 0;
+            if (entityIndex(entity) == index && signatures[index].test(typeId)) {
+                value = stateHash.hashers[typeId](*this, entity, stateHash.seeds[typeId] | entity);
+            }
+            stateHash.total += value - contributions[index];
+            contributions[index] = value;
+        }
+    }
+}
+
+static_assert(MAX_COMPONENTS <= 32, "Snapshot signatures are stored as 32-bit masks.");
+
+void World::saveSnapshot(std::vector<std::byte>& out) const {
+    SnapshotWriter writer(out);
+    writer.write(SNAPSHOT_MAGIC);
+    writer.write(SNAPSHOT_VERSION);
+    writer.write(uint16_t(0));
+    writer.write(static_cast<uint32_t>(registrationOrder.size()));
+    for (ComponentTypeId typeId : registrationOrder) {
+        writer.write(snapshotElementSizes[typeId]);
+    }
+
+    // Entity slot table, free list links included
+    uint32_t slotCount = static_cast<uint32_t>(entities.size());
+    writer.write(slotCount);
+    writer.write(freeListHead);
+    writer.write(livingEntityCount);
+    writer.writeBytes(entities.data(), slotCount * sizeof(EntityId));
+
+    // Signatures, with bits renumbered to registration order
+    std::vector<uint32_t> masks(slotCount, 0);
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        for (size_t bit = 0; bit < registrationOrder.size(); ++bit) {
+            if (signatures[i].test(registrationOrder[bit])) {
+                masks[i] |= 1u << bit;
+            }
+        }
+    }
+    writer.writeBytes(masks.data(), slotCount * sizeof(uint32_t));
+
+    for (ComponentTypeId typeId : registrationOrder) {
+        if (snapshotElementSizes[typeId] == 0) {
+            continue; // Tags live in the signatures
+        }
+#ifdef ENGINE_ECS_ARCHETYPES
+        // Same layout as ComponentArray::serialize: all handles, then all data
+        uint32_t elementSize = snapshotElementSizes[typeId];
+        writer.write(static_cast<uint32_t>(archetypes.countWith(typeId)));
+        archetypes.forEachColumn(typeId, [&](const EntityId* ids, const std::byte*,
+                                             uint32_t count) {
+            writer.writeBytes(ids, count * sizeof(EntityId));
+        });
+        archetypes.forEachColumn(typeId, [&](const EntityId*, const std::byte* column,
+                                             uint32_t count) {
+            writer.writeBytes(column, static_cast<size_t>(count) * elementSize);
+        });
+#else
+        componentArrays[typeId]->serialize(writer);
+#endif
+    }
+}
+
+bool World::loadSnapshot(const std::byte* data, size_t size) {
+    assert(entities.empty() && "Snapshots load into a fresh World.");
+
+    SnapshotReader reader(data, size);
+    if (readSnapshot(reader) && reader.remaining() == 0) {
+        markAllChanged();
+        return true;
+    }
+
+    // Malformed: drop whatever was restored so far
+    clear();
+    return false;
+}
+
+void World::clear() {
+    markAllChanged();
+    entities.clear();
+    signatures.clear();
+    freeListHead = NO_FREE_SLOT;
+    livingEntityCount = 0;
+#ifdef ENGINE_ECS_ARCHETYPES
+    archetypes.clear();
+#else
+    for (auto& array : componentArrays) {
+        if (array) {
+            array->clear();
+        }
+    }
+#endif
+}
+
+bool World::readSnapshot(SnapshotReader& reader) {
+    uint32_t magic = 0;
+    uint16_t version = 0;
+    uint16_t reserved = 0;
+    uint32_t componentCount = 0;
+    if (!reader.read(magic) || !reader.read(version) || !reader.read(reserved) ||
+        !reader.read(componentCount)) {
+        return false;
+    }
+    if (magic != SNAPSHOT_MAGIC || version != SNAPSHOT_VERSION ||
+        componentCount != registrationOrder.size()) {
+        return false;
+    }
+    for (ComponentTypeId typeId : registrationOrder) {
+        uint32_t elementSize = 0;
+        if (!reader.read(elementSize) || elementSize != snapshotElementSizes[typeId]) {
+            return false;
+        }
+    }
+
+    uint32_t slotCount = 0;
+    uint32_t freeHead = 0;
+    uint32_t living = 0;
+    if (!reader.read(slotCount) || !reader.read(freeHead) || !reader.read(living) ||
+        slotCount > MAX_ENTITIES || living > slotCount ||
+        !reader.canRead(slotCount, sizeof(EntityId) + sizeof(uint32_t))) {
+        return false;
+    }
+    entities.resize(slotCount);
+    reader.readBytes(entities.data(), slotCount * sizeof(EntityId));
+    std::vector<uint32_t> masks(slotCount);
+    reader.readBytes(masks.data(), slotCount * sizeof(uint32_t));
+
+    // Live slots hold their own index; the rest are retired or form one free list
+    uint32_t liveSlots = 0;
+    uint32_t retiredSlots = 0;
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        liveSlots += entityIndex(entities[i]) == i;
+        retiredSlots += entities[i] == RETIRED_SLOT;
+    }
+    uint32_t freeSlots = 0;
+    for (uint32_t index = freeHead; index != NO_FREE_SLOT; index = entityIndex(entities[index])) {
+        if (index >= slotCount || entityIndex(entities[index]) == index ||
+            entities[index] == RETIRED_SLOT || ++freeSlots > slotCount - living) {
+            return false;
+        }
+    }
+    if (liveSlots != living || freeSlots + retiredSlots != slotCount - living) {
+        return false;
+    }
+    freeListHead = freeHead;
+    livingEntityCount = living;
+    growChangeTicks();
+
+    uint32_t validBits = componentCount == 32 ? ~0u : (1u << componentCount) - 1;
+    std::array<uint32_t, MAX_COMPONENTS> owners{}; // Expected pool sizes, by bit
+    signatures.assign(slotCount, Signature());
+    for (uint32_t i = 0; i < slotCount; ++i) {
+        uint32_t mask = masks[i];
+        if ((mask & ~validBits) || (mask && entityIndex(entities[i]) != i)) {
+            return false;
+        }
+        for (uint32_t bit = 0; bit < componentCount; ++bit) {
+            if (mask & (1u << bit)) {
+                signatures[i].set(registrationOrder[bit]);
+                ++owners[bit];
+            }
+        }
+#ifdef ENGINE_ECS_ARCHETYPES
+        if (mask) {
+            archetypes.place(entities[i], signatures[i]);
+        }
+#endif
+    }
+
+#ifdef ENGINE_ECS_ARCHETYPES
+    std::vector<uint32_t> filled(slotCount, 0);
+#endif
+    for (uint32_t bit = 0; bit < componentCount; ++bit) {
+        ComponentTypeId typeId = registrationOrder[bit];
+        if (snapshotElementSizes[typeId] == 0) {
+            continue;
+        }
+#ifdef ENGINE_ECS_ARCHETYPES
+        uint32_t count = 0;
+        if (!reader.read(count) || count != owners[bit] ||
+            !reader.canRead(count, sizeof(EntityId))) {
+            return false;
+        }
+        std::vector<EntityId> handles(count);
+        reader.readBytes(handles.data(), count * sizeof(EntityId));
+        uint32_t elementSize = snapshotElementSizes[typeId];
+        if (!reader.canRead(count, elementSize)) {
+            return false;
+        }
+        for (EntityId entity : handles) {
+            uint32_t index = entityIndex(entity);
+            if (!isAlive(entity) || !signatures[index].test(typeId) || filled[index] == bit + 1) {
+                return false;
+            }
+            filled[index] = bit + 1;
+            reader.readBytes(archetypes.rawComponent(entity, typeId), elementSize);
+        }
+#else
+        // The pool rejects duplicates, so with matching sizes it's enough
+        // that every entity carrying the bit is in the pool
+        IComponentArray& array = *componentArrays[typeId];
+        if (!array.deserialize(reader) || array.size() != owners[bit]) {
+            return false;
+        }
+        for (uint32_t i = 0; i < slotCount; ++i) {
+            if (signatures[i].test(typeId) && !array.hasData(entities[i])) {
+                return false;
+            }
+        }
+#endif
+    }
+    return true;
+}
+
 } // namespace engine
@@ -1,8 +1,26 @@
 #include "engine/platform/Renderer.h"
+#ifndef ENGINE_NULL_RENDERER
 #include <GLFW/glfw3.h>
+#endif
+#include <algorithm>
 #include <cmath>
 
-Renderer::Renderer() {}
+namespace {
+
+uint8_t toByte(float channel) {
+    return static_cast<uint8_t>(std::clamp(channel, 0.0f, 1.0f) * 255.0f + 0.5f);
+}
+
+} // namespace
+
+Renderer::Renderer() {
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+        float angle = 2.0f * 3.14159f * i / CIRCLE_SEGMENTS;
+        unitCircle[i * 2] = cosf(angle);
+        unitCircle[i * 2 + 1] = sinf(angle);
+    }
+}
+
 Renderer::~Renderer() {}
 
 // ============================================================================
@@ -10,39 +28,72 @@ Renderer::~Renderer() {}
 // ============================================================================
 
 void Renderer::Clear() {
+    vertices.clear();
+    indices.clear();
+    drawCalls = 0;
+#ifndef ENGINE_NULL_RENDERER
     glClearColor(0.1f, 0.1f, 0.2f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
+#endif
+}
+
+uint32_t Renderer::BeginShape(size_t vertexCount) {
+    if (vertices.size() + vertexCount > MAX_BATCH_VERTICES) {
+        Flush();
+    }
+    return static_cast<uint32_t>(vertices.size());
 }
 
 void Renderer::RenderRectangle(float x, float y, float width, float height, float r, float g, float b) {
-    glColor3f(r, g, b);
+    uint32_t base = BeginShape(4);
+    uint8_t cr = toByte(r), cg = toByte(g), cb = toByte(b);
     float hw = width / 2.0f;
     float hh = height / 2.0f;
-    float rect[8] = {
-        x - hw, y - hh,
-        x + hw, y - hh,
-        x + hw, y + hh,
-        x - hw, y + hh
-    };
-    glEnableClientState(GL_VERTEX_ARRAY);
-    glVertexPointer(2, GL_FLOAT, 0, rect);
-    glDrawArrays(GL_QUADS, 0, 4);
-    glDisableClientState(GL_VERTEX_ARRAY);
+    vertices.push_back({x - hw, y - hh, cr, cg, cb, 255});
+    vertices.push_back({x + hw, y - hh, cr, cg, cb, 255});
+    vertices.push_back({x + hw, y + hh, cr, cg, cb, 255});
+    vertices.push_back({x - hw, y + hh, cr, cg, cb, 255});
+
+    const uint32_t quad[6] = {0, 1, 2, 0, 2, 3};
+    for (uint32_t index : quad) {
+        indices.push_back(base + index);
+    }
 }
 
 void Renderer::RenderCircle(float x, float y, float radius, float r, float g, float b) {
-    glColor3f(r, g, b);
-    const int segments = 32;
-    float vertices[segments * 2];
-    
-    for (int i = 0; i < segments; ++i) {
-        float angle = 2.0f * 3.14159f * i / segments;
-        vertices[i * 2] = x + radius * cosf(angle);
-        vertices[i * 2 + 1] = y + radius * sinf(angle);
+    // Centre vertex followed by the rim, fanned into triangles
+    uint32_t base = BeginShape(CIRCLE_SEGMENTS + 1);
+    uint8_t cr = toByte(r), cg = toByte(g), cb = toByte(b);
+    vertices.push_back({x, y, cr, cg, cb, 255});
+    for (int i = 0; i < CIRCLE_SEGMENTS; ++i) {
+        vertices.push_back({x + radius * unitCircle[i * 2], y + radius * unitCircle[i * 2 + 1],
+                            cr, cg, cb, 255});
+    }
+
+    for (uint32_t i = 0; i < CIRCLE_SEGMENTS; ++i) {
+        indices.push_back(base);
+        indices.push_back(base + 1 + i);
+        indices.push_back(base + 1 + (i + 1) % CIRCLE_SEGMENTS);
     }
-    
+}
+
+void Renderer::Flush() {
+    if (indices.empty()) {
+        return;
+    }
+
+#ifndef ENGINE_NULL_RENDERER
     glEnableClientState(GL_VERTEX_ARRAY);
-    glVertexPointer(2, GL_FLOAT, 0, vertices);
-    glDrawArrays(GL_TRIANGLE_FAN, 0, segments);
+    glEnableClientState(GL_COLOR_ARRAY);
+    glVertexPointer(2, GL_FLOAT, sizeof(Vertex), &vertices[0].x);
+    glColorPointer(4, GL_UNSIGNED_BYTE, sizeof(Vertex), &vertices[0].r);
+    glDrawElements(GL_TRIANGLES, static_cast<GLsizei>(indices.size()), GL_UNSIGNED_INT,
+                   indices.data());
+    glDisableClientState(GL_COLOR_ARRAY);
     glDisableClientState(GL_VERTEX_ARRAY);
+#endif
+
+    ++drawCalls;
+    vertices.clear();
+    indices.clear();
 }
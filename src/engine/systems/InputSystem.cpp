@@ -1,6 +1,6 @@
 #include "engine/systems/InputSystem.h"
 #include "engine/ecs/Entity.h"
-#include <cmath>
+#include "engine/systems/PlayerControl.h"
 
 namespace engine {
 
@@ -8,12 +8,13 @@ void InputSystem::update(World& world, float dt) {
     // Handle Recording Controls
     if (glfwGetKey(window, GLFW_KEY_F5) == GLFW_PRESS) {
         if (recorder.GetState() == InputRecorder::State::IDLE) {
-            recorder.StartRecording();
+            // Starts before the next tick, so the recording opens with a keyframe
+            recordingRequested = true;
         }
     }
     if (glfwGetKey(window, GLFW_KEY_F6) == GLFW_PRESS) {
         if (recorder.GetState() == InputRecorder::State::RECORDING) {
-            recorder.StopRecording("recording.bin");
+            recorder.StopRecording();
         } else if (recorder.GetState() == InputRecorder::State::PLAYBACK) {
             recorder.StopPlayback();
         }
@@ -25,13 +26,9 @@ void InputSystem::update(World& world, float dt) {
     }
 
     // Process input for all entities with PlayerInput component
-    for (EntityId entity = 0; entity < MAX_ENTITIES; ++entity) {
-        if (!world.hasComponent<game::PlayerInput>(entity)) {
-            continue;
-        }
-        
-        auto& input = world.getComponent<game::PlayerInput>(entity);
-        
+    world.view<const game::PlayerInput>().each(
+        [&](EntityId entity, const game::PlayerInput& current) {
+        game::PlayerInput input = current;
         // Only read keyboard if NOT playing back
         if (recorder.GetState() != InputRecorder::State::PLAYBACK) {
             // Read keyboard state
@@ -48,29 +45,36 @@ void InputSystem::update(World& world, float dt) {
         }
 
         // Process via recorder (saves if recording, overwrites if playing back)
-        recorder.ProcessInput(input);
+        if (entity == recorder.GetEntity() || !world.isAlive(recorder.GetEntity())) {
+            recorder.ProcessInput(input);
+        }
         
-        // Update velocity based on input (if entity has velocity)
-        if (world.hasComponent<game::Velocity>(entity)) {
-            auto& velocity = world.getComponent<game::Velocity>(entity);
-            
-            float speed = 0.5f; // Units per second
-            velocity.vx = 0.0f;
-            velocity.vy = 0.0f;
-            
-            if (input.moveUp) velocity.vy += speed;
-            if (input.moveDown) velocity.vy -= speed;
-            if (input.moveLeft) velocity.vx -= speed;
-            if (input.moveRight) velocity.vx += speed;
-            
-            // Normalize diagonal movement
-            if (velocity.vx != 0.0f && velocity.vy != 0.0f) {
-                float length = sqrtf(velocity.vx * velocity.vx + velocity.vy * velocity.vy);
-                velocity.vx = (velocity.vx / length) * speed;
-                velocity.vy = (velocity.vy / length) * speed;
+        // Store the input and update velocity (if entity has velocity)
+        storePlayerInput(world, entity, input);
+    });
+}
+
+void InputSystem::captureKeyframe(World& world) {
+    if (recordingRequested) {
+        recordingRequested = false;
+        // Record the first player; the replay header remembers which one it was
+        EntityId player = INVALID_ENTITY;
+        world.view<const game::PlayerInput>().each(
+            [&](EntityId entity, const game::PlayerInput&) {
+            if (player == INVALID_ENTITY) {
+                player = entity;
             }
-        }
+        });
+        recorder.StartRecording("recording.bin", 60, player);
+    }
+
+    if (recorder.GetState() != InputRecorder::State::RECORDING ||
+        recorder.GetFrameCount() % KEYFRAME_INTERVAL != 0) {
+        return;
     }
+    keyframe.clear();
+    world.saveSnapshot(keyframe);
+    recorder.AddKeyframe(keyframe);
 }
 
 } // namespace engine
@@ -1,20 +1,12 @@
 #include "engine/systems/MovementSystem.h"
 #include "engine/ecs/Entity.h"
+#include <algorithm>
 
 namespace engine {
 
 void MovementSystem::update(World& world, float dt) {
-    // Apply velocity to all entities with Transform + Velocity
-    for (EntityId entity = 0; entity < MAX_ENTITIES; ++entity) {
-        if (!world.hasComponent<game::Transform>(entity) ||
-            !world.hasComponent<game::Velocity>(entity)) {
-            continue;
-        }
-        
-        auto& transform = world.getComponent<game::Transform>(entity);
-        auto& velocity = world.getComponent<game::Velocity>(entity);
-        
-        // Save previous position for interpolation
+    auto integrate = [&](EntityId entity, game::Transform& transform,
+                         const game::Velocity& velocity) {
         if (world.hasComponent<game::PreviousTransform>(entity)) {
             auto& prev = world.getComponent<game::PreviousTransform>(entity);
             prev.x = transform.x;
@@ -22,17 +14,62 @@ void MovementSystem::update(World& world, float dt) {
             prev.rotation = transform.rotation;
         }
 
-        // Update position
-        transform.x += velocity.vx * dt;
-        transform.y += velocity.vy * dt;
-        
-        // Simple boundary clamping (to keep entities on screen)
-        const float worldSize = 0.9f;
-        if (transform.x < -worldSize) transform.x = -worldSize;
-        if (transform.x > worldSize) transform.x = worldSize;
-        if (transform.y < -worldSize) transform.y = -worldSize;
-        if (transform.y > worldSize) transform.y = worldSize;
+        float x = transform.x + velocity.vx * dt;
+        float y = transform.y + velocity.vy * dt;
+        if (x < -WORLD_SIZE) x = -WORLD_SIZE;
+        if (x > WORLD_SIZE) x = WORLD_SIZE;
+        if (y < -WORLD_SIZE) y = -WORLD_SIZE;
+        if (y > WORLD_SIZE) y = WORLD_SIZE;
+        transform.x = x;
+        transform.y = y;
+    };
+
+    // Each entity only touches its own components, so slices can run in
+    // parallel. Velocity is only read: a const view leaves its change stamps alone.
+    auto movers = world.view<game::Transform, const game::Velocity>();
+    if (threadPool) {
+        movers.parallelEach(*threadPool, integrate, GRAIN_SIZE);
+    } else {
+        movers.each(integrate);
+    }
+
+    if (spatialGrid) {
+        rebuildSpatialGrid(world);
     }
 }
 
+void MovementSystem::rebuildSpatialGrid(World& world) {
+    // Boxes span the previous and current position so they cover every
+    // interpolated position drawn until the next tick
+    spatialGrid->clear();
+    world.view<const game::Transform>().each(
+        [&](EntityId entity, const game::Transform& transform) {
+        float halfWidth = 0.0f;
+        float halfHeight = 0.0f;
+        if (world.hasComponent<game::Renderable>(entity)) {
+            const auto& renderable = world.readComponent<game::Renderable>(entity);
+            if (renderable.shape == game::Renderable::Shape::Circle) {
+                halfWidth = halfHeight = (renderable.width + renderable.height) / 4.0f;
+            } else {
+                halfWidth = renderable.width / 2.0f;
+                halfHeight = renderable.height / 2.0f;
+            }
+        }
+
+        float minX = transform.x, maxX = transform.x;
+        float minY = transform.y, maxY = transform.y;
+        if (world.hasComponent<game::PreviousTransform>(entity)) {
+            const auto& prev = world.readComponent<game::PreviousTransform>(entity);
+            minX = std::min(minX, prev.x);
+            maxX = std::max(maxX, prev.x);
+            minY = std::min(minY, prev.y);
+            maxY = std::max(maxY, prev.y);
+        }
+
+        spatialGrid->insert(entity, transform.x, transform.y, minX - halfWidth, minY - halfHeight,
+                            maxX + halfWidth, maxY + halfHeight);
+    });
+    spatialGrid->build();
+}
+
 } // namespace engine
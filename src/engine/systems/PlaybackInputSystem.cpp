@@ -0,0 +1,38 @@
+#include "engine/systems/PlaybackInputSystem.h"
+#include "engine/core/Logger.h"
+#include "engine/ecs/Entity.h"
+#include "engine/systems/PlayerControl.h"
+
+namespace engine {
+
+void PlaybackInputSystem::update(World& world, float) {
+    // Replays drive the entity they were recorded from; if that one doesn't
+    // exist here, every player follows the recording
+    EntityId recorded = recorder.GetEntity();
+    bool everyPlayer = !world.isAlive(recorded);
+    world.view<const game::PlayerInput>().each(
+        [&](EntityId entity, const game::PlayerInput& current) {
+        game::PlayerInput input = current;
+        if (everyPlayer || entity == recorded) {
+            recorder.ProcessInput(input);
+        }
+        storePlayerInput(world, entity, input);
+    });
+}
+
+bool PlaybackInputSystem::seekToKeyframe(World& world, uint64_t frame, uint64_t& keyframeFrame) {
+    InputKeyframe keyframe;
+    if (!recorder.FindKeyframe(frame, keyframe) || !recorder.SeekToFrame(keyframe.frame)) {
+        return false;
+    }
+
+    world.clear();
+    if (!world.loadSnapshot(keyframe.data, keyframe.size)) {
+        Logger::Error("Keyframe at frame ", keyframe.frame, " does not match this World");
+        return false;
+    }
+    keyframeFrame = keyframe.frame;
+    return true;
+}
+
+} // namespace engine
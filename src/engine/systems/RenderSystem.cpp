@@ -1,7 +1,5 @@
 #include "engine/systems/RenderSystem.h"
 #include "engine/ecs/Entity.h"
-#include <cmath>
-#include <vector>
 #include <algorithm>
 
 namespace engine {
@@ -9,53 +7,128 @@ namespace engine {
 void RenderSystem::update(World& world, float alpha) {
     // Clear screen
     renderer.Clear();
+    ++frame;
     
-    // Collect all entities with Transform + Renderable
-    struct RenderableEntity {
-        EntityId id;
-        float x, y; // Interpolated position
-        game::Renderable* renderable;
-    };
-    
-    std::vector<RenderableEntity> renderables;
-    
-    // Iterate through all possible entity IDs
-    for (EntityId entity = 0; entity < MAX_ENTITIES; ++entity) {
-        if (world.hasComponent<game::Transform>(entity) && 
-            world.hasComponent<game::Renderable>(entity)) {
-            
-            auto& transform = world.getComponent<game::Transform>(entity);
-            auto& renderable = world.getComponent<game::Renderable>(entity);
-            
-            float x = transform.x;
-            float y = transform.y;
-            
-            // Interpolate if we have previous state
-            if (world.hasComponent<game::PreviousTransform>(entity)) {
-                auto& prev = world.getComponent<game::PreviousTransform>(entity);
-                x = prev.x * (1.0f - alpha) + transform.x * alpha;
-                y = prev.y * (1.0f - alpha) + transform.y * alpha;
-            }
+    // Refresh interpolated positions in place; only entities that are new or
+    // changed layer move between buckets
+    size_t seenCount = 0;
+    world.view<const game::Transform, const game::Renderable>().each(
+        [&](EntityId entity, const game::Transform& transform, const game::Renderable& renderable) {
+        float x = transform.x;
+        float y = transform.y;
+        
+        // Interpolate if we have previous state
+        if (world.hasComponent<game::PreviousTransform>(entity)) {
+            const auto& prev = world.readComponent<game::PreviousTransform>(entity);
+            x = prev.x * (1.0f - alpha) + transform.x * alpha;
+            y = prev.y * (1.0f - alpha) + transform.y * alpha;
+        }
 
-            renderables.push_back({entity, x, y, &renderable});
+        size_t index = entityIndex(entity);
+        if (index >= slots.size()) {
+            slots.resize(index + 1);
+        }
+        Slot* slot = &slots[index];
+        if (slot->entity != entity || layers[slot->bucket].layer != renderable.layer) {
+            if (slot->entity != INVALID_ENTITY) {
+                dequeue(index);
+            }
+            enqueue(entity, renderable.layer);
+            slot = &slots[index];
         }
+
+        QueueEntry& entry = layers[slot->bucket].entries[slot->position];
+        entry.x = x;
+        entry.y = y;
+        entry.renderable = &renderable;
+        slot->lastSeen = frame;
+        ++seenCount;
+    });
+
+    // Something stopped rendering (destroyed or lost a component)
+    if (seenCount != queuedCount) {
+        sweepStale();
     }
     
-    // Sort by layer (lower layers drawn first)
-    std::sort(renderables.begin(), renderables.end(), 
-        [](const RenderableEntity& a, const RenderableEntity& b) {
-            return a.renderable->layer < b.renderable->layer;
+    // Mark what the grid sees on screen. Entities it hasn't indexed yet
+    // (created since the last movement tick) are always drawn.
+    if (spatialGrid) {
+        spatialGrid->queryRange(viewMinX, viewMinY, viewMaxX, viewMaxY, [&](EntityId entity) {
+            size_t index = entityIndex(entity);
+            if (index < slots.size() && slots[index].entity == entity) {
+                slots[index].visible = frame;
+            }
         });
+    }
     
-    // Render all entities
-    for (const auto& re : renderables) {
-        const auto& r = *re.renderable;
-        
-        if (r.shape == game::Renderable::Shape::Rectangle) {
-            renderer.RenderRectangle(re.x, re.y, r.width, r.height, r.r, r.g, r.b);
-        } else if (r.shape == game::Renderable::Shape::Circle) {
-            float radius = (r.width + r.height) / 4.0f; // Average for circle radius
-            renderer.RenderCircle(re.x, re.y, radius, r.r, r.g, r.b);
+    // Buckets are already in layer order (lower layers drawn first)
+    culledCount = 0;
+    for (const auto& bucket : layers) {
+        for (const auto& entry : bucket.entries) {
+            if (spatialGrid && slots[entityIndex(entry.entity)].visible != frame &&
+                spatialGrid->contains(entry.entity)) {
+                ++culledCount;
+                continue;
+            }
+
+            const auto& r = *entry.renderable;
+
+            if (r.shape == game::Renderable::Shape::Rectangle) {
+                renderer.RenderRectangle(entry.x, entry.y, r.width, r.height, r.r, r.g, r.b);
+            } else if (r.shape == game::Renderable::Shape::Circle) {
+                float radius = (r.width + r.height) / 4.0f; // Average for circle radius
+                renderer.RenderCircle(entry.x, entry.y, radius, r.r, r.g, r.b);
+            }
+        }
+    }
+
+    // Submit the whole frame's batch
+    renderer.Flush();
+}
+
+void RenderSystem::enqueue(EntityId entity, int layer) {
+    auto it = std::lower_bound(layers.begin(), layers.end(), layer,
+        [](const LayerBucket& bucket, int value) { return bucket.layer < value; });
+    if (it == layers.end() || it->layer != layer) {
+        // New layer: later buckets shift, so fix up their slots
+        size_t inserted = static_cast<size_t>(it - layers.begin());
+        layers.insert(it, LayerBucket{layer, {}});
+        for (size_t b = inserted + 1; b < layers.size(); ++b) {
+            for (const auto& entry : layers[b].entries) {
+                slots[entityIndex(entry.entity)].bucket = static_cast<uint32_t>(b);
+            }
+        }
+        it = layers.begin() + static_cast<std::ptrdiff_t>(inserted);
+    }
+
+    Slot& slot = slots[entityIndex(entity)];
+    slot.entity = entity;
+    slot.bucket = static_cast<uint32_t>(it - layers.begin());
+    slot.position = static_cast<uint32_t>(it->entries.size());
+    it->entries.push_back({entity, 0.0f, 0.0f, nullptr});
+    ++queuedCount;
+}
+
+void RenderSystem::dequeue(size_t index) {
+    // Swap-remove; order within a layer is unspecified, as with the old sort
+    Slot& slot = slots[index];
+    auto& entries = layers[slot.bucket].entries;
+    QueueEntry& last = entries.back();
+    slots[entityIndex(last.entity)].position = slot.position;
+    entries[slot.position] = last;
+    entries.pop_back();
+
+    slot.entity = INVALID_ENTITY;
+    --queuedCount;
+}
+
+void RenderSystem::sweepStale() {
+    for (auto& bucket : layers) {
+        for (size_t i = bucket.entries.size(); i-- > 0;) {
+            size_t index = entityIndex(bucket.entries[i].entity);
+            if (slots[index].lastSeen != frame) {
+                dequeue(index);
+            }
         }
     }
 }
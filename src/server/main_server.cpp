@@ -0,0 +1,231 @@
+// Headless simulation server: runs the fixed-timestep loop without a window
+// or GPU. Input comes from an InputRecorder recording instead of a keyboard.
+//
+//   server [--ticks N] [--fast] [--rate HZ] [--entities N] [--threads N]
+//          [--replay FILE] [--seed N] [--hash-every N] [--binlog FILE]
+//          [--profile] [--trace FILE]
+//
+// --fast runs ticks back to back instead of pacing them in real time, and
+// --threads 0 keeps everything on the calling thread so many servers can
+// share one core.
+//
+// With --replay the run starts from the recording's first keyframe (or the
+// seeded scene if it has none), ticks at the recording's rate unless --rate
+// is given, and stops when the recording ends. --hash-every prints the World
+// state hash every N ticks, so two runs can be diffed for determinism. The
+// hash is incremental, so even --hash-every 1 barely slows the run:
+//
+//   server --replay recording.bin --fast --threads 0 --hash-every 1
+//
+// --binlog writes spawns and per-tick timings to a binary log; read it with
+// binlog_decode. --profile logs per-system timings every second and --trace
+// writes every tick and system update to a Chrome trace file.
+#include "engine/core/BinaryLog.h"
+#include "engine/core/Logger.h"
+#include "engine/core/Simulation.h"
+#include "engine/systems/MovementSystem.h"
+#include "engine/systems/PlaybackInputSystem.h"
+#include <atomic>
+#include <chrono>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <string>
+#include <thread>
+
+namespace {
+
+struct ServerOptions {
+    uint64_t ticks = 0; // 0 runs until interrupted
+    bool fast = false;
+    double tickRate = 60.0;
+    bool tickRateSet = false;
+    size_t entities = 1000;
+    size_t threads = engine::ThreadPool::defaultWorkerCount();
+    std::string replayFile;
+    uint32_t seed = 1;
+    uint64_t hashEvery = 0; // 0 only hashes at exit
+    std::string binaryLogFile;
+    bool profile = false;
+    std::string traceFile;
+};
+
+std::atomic<bool> stopRequested{false};
+
+void handleSignal(int) {
+    stopRequested.store(true);
+}
+
+bool parseOptions(int argc, char** argv, ServerOptions& options) {
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        if (arg == "--fast") {
+            options.fast = true;
+        } else if (arg == "--ticks" && hasValue) {
+            options.ticks = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--rate" && hasValue) {
+            options.tickRate = std::strtod(argv[++i], nullptr);
+            options.tickRateSet = true;
+        } else if (arg == "--entities" && hasValue) {
+            options.entities = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--replay" && hasValue) {
+            options.replayFile = argv[++i];
+        } else if (arg == "--seed" && hasValue) {
+            options.seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else if (arg == "--hash-every" && hasValue) {
+            options.hashEvery = std::strtoull(argv[++i], nullptr, 10);
+        } else if (arg == "--binlog" && hasValue) {
+            options.binaryLogFile = argv[++i];
+        } else if (arg == "--profile") {
+            options.profile = true;
+        } else if (arg == "--trace" && hasValue) {
+            options.traceFile = argv[++i];
+        } else {
+            engine::Logger::Error("Unknown or incomplete option: ", arg);
+            return false;
+        }
+    }
+    return options.tickRate > 0.0;
+}
+
+// Same scene for the same seed, so runs can be compared tick for tick
+void createEntities(engine::World& world, const ServerOptions& options) {
+    engine::EntityId player = world.createEntity();
+    world.addComponent(player, game::Transform{0.0f, 0.0f, 0.0f});
+    world.addComponent(player, game::PreviousTransform{0.0f, 0.0f, 0.0f});
+    world.addComponent(player, game::Velocity{0.0f, 0.0f});
+    world.addComponent(player, game::PlayerInput{});
+    world.addComponent(player, game::Player{});
+
+    std::mt19937 rng(options.seed);
+    std::uniform_real_distribution<float> position(-0.9f, 0.9f);
+    std::uniform_real_distribution<float> speed(-0.3f, 0.3f);
+    for (size_t i = 0; i < options.entities; ++i) {
+        engine::EntityId enemy = world.createEntity();
+        game::Transform transform{position(rng), position(rng), 0.0f};
+        world.addComponent(enemy, transform);
+        world.addComponent(enemy, game::PreviousTransform{transform.x, transform.y, 0.0f});
+        world.addComponent(enemy, game::Velocity{speed(rng), speed(rng)});
+        world.addComponent(enemy, game::Enemy{});
+        ENGINE_BINARY_LOG(engine::LogLevel::DEBUG, "spawned enemy {} at {}, {}", enemy,
+                          transform.x, transform.y);
+    }
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    ServerOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        return 1;
+    }
+    std::signal(SIGINT, handleSignal);
+    std::signal(SIGTERM, handleSignal);
+    if (!options.binaryLogFile.empty() && !engine::BinaryLog::Open(options.binaryLogFile)) {
+        return 1;
+    }
+
+    engine::Simulation simulation(options.threads);
+    simulation.enableStateHash();
+    bool replaying = !options.replayFile.empty();
+    auto& playback = static_cast<engine::PlaybackInputSystem&>(simulation.addSystem(
+        replaying ? std::make_unique<engine::PlaybackInputSystem>(options.replayFile)
+                  : std::make_unique<engine::PlaybackInputSystem>()));
+    simulation.addSystem(std::make_unique<engine::MovementSystem>(
+        options.threads > 0 ? &simulation.getThreadPool() : nullptr,
+        &simulation.getSpatialGrid()));
+    createEntities(simulation.getWorld(), options);
+
+    if (replaying) {
+        if (!playback.isPlaying()) {
+            return 1;
+        }
+        const engine::InputRecorder& recording = playback.getRecorder();
+        uint64_t keyframeFrame = 0;
+        if (playback.seekToKeyframe(simulation.getWorld(), 0, keyframeFrame)) {
+            engine::Logger::Info("Replaying from the recording's initial keyframe");
+        }
+        if (!options.tickRateSet && recording.GetTickRate() > 0) {
+            options.tickRate = recording.GetTickRate();
+        }
+        if (options.ticks == 0) {
+            options.ticks = recording.GetFrameCount();
+        }
+    }
+
+    const float dt = static_cast<float>(1.0 / options.tickRate);
+    const auto period = std::chrono::duration_cast<std::chrono::steady_clock::duration>(
+        std::chrono::duration<double>(1.0 / options.tickRate));
+    engine::Logger::Info("Headless server: ", options.entities, " entities, ", options.tickRate,
+                         " Hz, ", options.fast ? "unpaced" : "real-time", ", ", options.threads,
+                         " worker threads");
+
+    engine::Profiler& profiler = simulation.getProfiler();
+    profiler.setEnabled(options.profile || !options.traceFile.empty());
+    if (!options.traceFile.empty()) {
+        profiler.startTrace();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    auto nextTick = start;
+    auto nextStats = start + std::chrono::seconds(1);
+    while (!stopRequested.load() &&
+           (options.ticks == 0 || simulation.getTickCount() < options.ticks)) {
+        // A recording cut short has no frame count; stop once it runs dry
+        if (replaying && !playback.isPlaying()) {
+            break;
+        }
+        auto tickStart = std::chrono::steady_clock::now();
+        simulation.update(dt);
+        std::chrono::duration<float, std::micro> tickTime =
+            std::chrono::steady_clock::now() - tickStart;
+
+        uint64_t tick = simulation.getTickCount();
+        ENGINE_BINARY_LOG(engine::LogLevel::INFO, "tick {} took {} us", tick, tickTime.count());
+        if (options.hashEvery > 0 && tick % options.hashEvery == 0) {
+            std::printf("tick %llu hash %016llx\n", static_cast<unsigned long long>(tick),
+                        static_cast<unsigned long long>(simulation.getWorld().getStateHash()));
+        }
+        if (options.profile && std::chrono::steady_clock::now() >= nextStats) {
+            profiler.logStats();
+            nextStats += std::chrono::seconds(1);
+        }
+
+        if (!options.fast) {
+            nextTick += period;
+            auto now = std::chrono::steady_clock::now();
+            if (now - nextTick > std::chrono::milliseconds(250)) {
+                // Too far behind to catch up (prevent spiral of death); resync
+                nextTick = now;
+            } else {
+                std::this_thread::sleep_until(nextTick);
+            }
+        }
+    }
+
+    auto elapsed = std::chrono::steady_clock::now() - start;
+    double seconds = std::chrono::duration<double>(elapsed).count();
+    uint64_t ticks = simulation.getTickCount();
+    char hash[17];
+    std::snprintf(hash, sizeof(hash), "%016llx",
+                  static_cast<unsigned long long>(simulation.getWorld().getStateHash()));
+    engine::Logger::Info("Ran ", ticks, " ticks in ", seconds, " s (",
+                         seconds > 0.0 ? ticks / seconds : 0.0, " ticks/s), state hash ", hash);
+    if (options.profile) {
+        profiler.logStats(); // The last, partial second
+    }
+    if (!options.traceFile.empty()) {
+        if (!profiler.writeTrace(options.traceFile)) {
+            engine::Logger::Error("Failed to write trace: ", options.traceFile);
+        }
+    }
+    engine::BinaryLog::Close();
+    return 0;
+}
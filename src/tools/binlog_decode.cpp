@@ -0,0 +1,93 @@
+// Prints a binary log written through ENGINE_BINARY_LOG as text, in the
+// same format as the console log:
+//
+//   binlog_decode [--sources] FILE
+//
+// --sources appends the file and line of each log site.
+#include "engine/core/BinaryLog.h"
+#include <cstdio>
+#include <ctime>
+#include <string>
+
+namespace {
+
+const char* levelName(engine::LogLevel level) {
+    switch (level) {
+        case engine::LogLevel::DEBUG: return "DEBUG";
+        case engine::LogLevel::INFO: return "INFO ";
+        case engine::LogLevel::WARN: return "WARN ";
+        case engine::LogLevel::ERROR: return "ERROR";
+    }
+    return "?????";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    bool sources = false;
+    std::string path;
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--sources") {
+            sources = true;
+        } else if (path.empty() && arg.rfind("--", 0) != 0) {
+            path = arg;
+        } else {
+            std::fprintf(stderr, "usage: binlog_decode [--sources] FILE\n");
+            return 2;
+        }
+    }
+    if (path.empty()) {
+        std::fprintf(stderr, "usage: binlog_decode [--sources] FILE\n");
+        return 2;
+    }
+
+    engine::BinaryLogReader reader;
+    if (!reader.Open(path)) {
+        std::fprintf(stderr, "Not a binary log (or unsupported version): %s\n", path.c_str());
+        return 1;
+    }
+
+    engine::BinaryLogEvent event;
+    uint64_t count = 0;
+    int64_t cachedSecond = -1;
+    char clock[16] = {};
+    while (reader.Next(event)) {
+        int64_t second = event.timestampNs / 1000000000;
+        if (second != cachedSecond) {
+            std::time_t time = static_cast<std::time_t>(second);
+            std::tm local{};
+#ifdef _WIN32
+            localtime_s(&local, &time);
+#else
+            localtime_r(&time, &local);
+#endif
+            std::strftime(clock, sizeof(clock), "%H:%M:%S", &local);
+            cachedSecond = second;
+        }
+        std::printf("[%s.%03d] [%s] %s", clock,
+                    static_cast<int>(event.timestampNs / 1000000 % 1000), levelName(event.level),
+                    event.text.c_str());
+        if (sources) {
+            std::printf(" (%.*s:%u)", static_cast<int>(event.file.size()), event.file.data(),
+                        event.line);
+        }
+        std::putchar('\n');
+        count++;
+    }
+
+    if (reader.IsCorrupt()) {
+        std::fprintf(stderr, "Corrupt record after %llu records\n",
+                     static_cast<unsigned long long>(count));
+        return 1;
+    }
+    if (!reader.WasClosed()) {
+        std::fprintf(stderr, "Log was not closed; showing the %llu records written\n",
+                     static_cast<unsigned long long>(count));
+    }
+    if (reader.GetDroppedCount() > 0) {
+        std::fprintf(stderr, "%llu records were dropped because the log was full\n",
+                     static_cast<unsigned long long>(reader.GetDroppedCount()));
+    }
+    return 0;
+}
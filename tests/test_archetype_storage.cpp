@@ -0,0 +1,80 @@
+#include "doctest.h"
+#include "engine/ecs/ArchetypeStorage.h"
+#include "game/components/GameComponents.h"
+
+namespace {
+
+engine::ArchetypeStorage makeStorage() {
+    engine::ArchetypeStorage storage;
+    storage.registerComponent<game::Transform>();
+    storage.registerComponent<game::Velocity>();
+    storage.registerComponent<game::Enemy>();
+    return storage;
+}
+
+} // namespace
+
+TEST_CASE("ArchetypeStorage") {
+    engine::ArchetypeStorage storage = makeStorage();
+
+    SUBCASE("Components survive archetype moves") {
+        storage.add(7, game::Transform{1.0f, 2.0f, 3.0f});
+        storage.add(7, game::Velocity{4.0f, 5.0f});
+
+        CHECK(storage.has<game::Transform>(7));
+        CHECK(storage.has<game::Velocity>(7));
+        CHECK(storage.get<game::Transform>(7).rotation == 3.0f);
+    }
+
+    SUBCASE("Entities sharing a signature share an archetype") {
+        for (engine::EntityId entity = 0; entity < 100; ++entity) {
+            storage.add(entity, game::Transform{static_cast<float>(entity), 0.0f, 0.0f});
+            if (entity % 2 == 0) {
+                storage.add(entity, game::Velocity{1.0f, 0.0f});
+            }
+        }
+        // {Transform}, {Transform, Velocity}
+        CHECK(storage.getArchetypeCount() == 2);
+
+        storage.remove<game::Velocity>(10);
+        CHECK_FALSE(storage.has<game::Velocity>(10));
+        CHECK(storage.get<game::Transform>(10).x == 10.0f);
+        CHECK(storage.get<game::Transform>(12).x == 12.0f);
+    }
+
+    SUBCASE("Rows spill into further chunks and stay packed on destroy") {
+        const engine::EntityId count = 5000;
+        for (engine::EntityId entity = 0; entity < count; ++entity) {
+            storage.add(entity, game::Transform{static_cast<float>(entity), 0.0f, 0.0f});
+            storage.add(entity, game::Velocity{0.0f, static_cast<float>(entity)});
+        }
+        for (engine::EntityId entity = 0; entity < count; entity += 3) {
+            storage.destroy(entity);
+        }
+
+        int visited = 0;
+        bool consistent = true;
+        storage.each<game::Transform, game::Velocity>(
+            [&](engine::EntityId entity, game::Transform& transform, game::Velocity& velocity) {
+            consistent = consistent && entity % 3 != 0 &&
+                         transform.x == static_cast<float>(entity) && velocity.vy == transform.x;
+            visited++;
+        });
+        CHECK(consistent);
+        CHECK(visited == count - (count + 2) / 3);
+    }
+
+    SUBCASE("Tag components filter queries") {
+        storage.add(1, game::Transform{});
+        storage.add(2, game::Transform{});
+        storage.add(2, game::Enemy{});
+
+        int enemies = 0;
+        storage.each<game::Transform, game::Enemy>(
+            [&](engine::EntityId entity, game::Transform&, game::Enemy&) {
+            CHECK(entity == 2);
+            enemies++;
+        });
+        CHECK(enemies == 1);
+    }
+}
@@ -0,0 +1,166 @@
+#include "doctest.h"
+#include "engine/core/BinaryLog.h"
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+enum class Side { LEFT = 3 };
+
+std::vector<std::string> decodeAll(const std::string& path, engine::BinaryLogReader& reader) {
+    std::vector<std::string> lines;
+    REQUIRE(reader.Open(path));
+    engine::BinaryLogEvent event;
+    while (reader.Next(event)) {
+        lines.push_back(event.text);
+    }
+    return lines;
+}
+
+} // namespace
+
+// Sites log at ERROR so that every ENGINE_LOG_MIN_LEVEL keeps them
+TEST_CASE("BinaryLog") {
+    const std::string path = "test_binary_log.bin";
+
+    SUBCASE("Round trip of every argument type") {
+        REQUIRE(engine::BinaryLog::Open(path));
+        std::string name = "goblin";
+        for (int i = 0; i < 3; ++i) {
+            ENGINE_BINARY_LOG(engine::LogLevel::ERROR, "spawned {} ({}) at {}, {}",
+                              uint32_t(100 + i), name, 0.5f * i, -1.25);
+        }
+        ENGINE_BINARY_LOG(engine::LogLevel::ERROR, "mixed {} {} {} {} {} {} {} {}", true, 'x',
+                          int8_t('y'), uint16_t(65535), int64_t(-1234567890123ll),
+                          UINT64_MAX, Side::LEFT, "literal");
+        ENGINE_BINARY_LOG(engine::LogLevel::ERROR, "no placeholders", 1, 2);
+        ENGINE_BINARY_LOG(engine::LogLevel::ERROR, "missing {} {}", 7);
+        engine::BinaryLog::Close();
+
+        engine::BinaryLogReader reader;
+        std::vector<std::string> lines = decodeAll(path, reader);
+        CHECK_FALSE(reader.IsCorrupt());
+        CHECK(reader.WasClosed());
+        REQUIRE(lines.size() == 6);
+        CHECK(lines[0] == "spawned 100 (goblin) at 0, -1.25");
+        CHECK(lines[2] == "spawned 102 (goblin) at 1, -1.25");
+        CHECK(lines[3] == "mixed 1 x y 65535 -1234567890123 18446744073709551615 3 literal");
+        CHECK(lines[4] == "no placeholders 1 2");
+        CHECK(lines[5] == "missing 7 {}");
+
+        engine::BinaryLogEvent event;
+        REQUIRE(reader.Open(path));
+        REQUIRE(reader.Next(event));
+        CHECK(event.level == engine::LogLevel::ERROR);
+        CHECK(event.file.find("test_binary_log.cpp") != std::string_view::npos);
+        CHECK(event.line > 0);
+    }
+
+    SUBCASE("Sites registered earlier are defined in a new log") {
+        auto logOnce = [] { ENGINE_BINARY_LOG(engine::LogLevel::ERROR, "value {}", 42); };
+        REQUIRE(engine::BinaryLog::Open(path));
+        logOnce();
+        engine::BinaryLog::Close();
+        REQUIRE(engine::BinaryLog::Open(path));
+        logOnce();
+        engine::BinaryLog::Close();
+
+        engine::BinaryLogReader reader;
+        std::vector<std::string> lines = decodeAll(path, reader);
+        CHECK_FALSE(reader.IsCorrupt());
+        REQUIRE(lines.size() == 1);
+        CHECK(lines[0] == "value 42");
+    }
+
+    SUBCASE("Nothing is written while closed or filtered out") {
+        ENGINE_BINARY_LOG(engine::LogLevel::ERROR, "closed {}", 1);
+        REQUIRE(engine::BinaryLog::Open(path));
+        engine::Logger::SetLevel(engine::LogLevel::ERROR);
+        ENGINE_BINARY_LOG(engine::LogLevel::WARN, "filtered {}", 2);
+        engine::Logger::SetLevel(engine::LogLevel::DEBUG);
+        ENGINE_BINARY_LOG(engine::LogLevel::ERROR, "kept {}", 3);
+        engine::BinaryLog::Close();
+
+        engine::BinaryLogReader reader;
+        std::vector<std::string> lines = decodeAll(path, reader);
+        REQUIRE(lines.size() == 1);
+        CHECK(lines[0] == "kept 3");
+    }
+
+    SUBCASE("Several threads") {
+        REQUIRE(engine::BinaryLog::Open(path));
+        constexpr int THREADS = 4;
+        constexpr int PER_THREAD = 5000;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([t] {
+                for (int i = 0; i < PER_THREAD; ++i) {
+                    ENGINE_BINARY_LOG(engine::LogLevel::ERROR, "thread {} event {}", t, i);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        engine::BinaryLog::Close();
+
+        engine::BinaryLogReader reader;
+        std::vector<std::string> lines = decodeAll(path, reader);
+        CHECK_FALSE(reader.IsCorrupt());
+        REQUIRE(lines.size() == THREADS * PER_THREAD);
+        std::vector<int> next(THREADS, 0);
+        for (const std::string& line : lines) {
+            int thread = -1;
+            int index = -1;
+            REQUIRE(std::sscanf(line.c_str(), "thread %d event %d", &thread, &index) == 2);
+            CHECK(index == next[thread]);
+            next[thread] = index + 1;
+        }
+    }
+
+    SUBCASE("Full log drops and counts records") {
+        REQUIRE(engine::BinaryLog::Open(path, 1000));
+        for (int i = 0; i < 100; ++i) {
+            ENGINE_BINARY_LOG(engine::LogLevel::ERROR, "event {}", i);
+        }
+        uint64_t dropped = engine::BinaryLog::GetDroppedCount();
+        engine::BinaryLog::Close();
+
+        engine::BinaryLogReader reader;
+        std::vector<std::string> lines = decodeAll(path, reader);
+        CHECK_FALSE(reader.IsCorrupt());
+        CHECK(dropped > 0);
+        CHECK(reader.GetDroppedCount() == dropped);
+        CHECK(lines.size() + dropped == 100);
+        CHECK(lines.back() == "event " + std::to_string(lines.size() - 1));
+    }
+
+    SUBCASE("A log that was never closed reads up to where it stopped") {
+        REQUIRE(engine::BinaryLog::Open(path));
+        for (int i = 0; i < 10; ++i) {
+            ENGINE_BINARY_LOG(engine::LogLevel::ERROR, "event {}", i);
+        }
+        // The mapping is shared, so the file already holds the records
+        engine::BinaryLogReader reader;
+        std::vector<std::string> lines = decodeAll(path, reader);
+        CHECK_FALSE(reader.WasClosed());
+        CHECK_FALSE(reader.IsCorrupt());
+        CHECK(lines.size() == 10);
+        engine::BinaryLog::Close();
+    }
+
+    SUBCASE("Rejects other files") {
+        {
+            std::ofstream out(path, std::ios::binary | std::ios::trunc);
+            out << "not a binary log at all, but long enough for a header";
+        }
+        engine::BinaryLogReader reader;
+        CHECK_FALSE(reader.Open(path));
+        CHECK_FALSE(reader.Open("does_not_exist.bin"));
+    }
+
+    std::remove(path.c_str());
+}
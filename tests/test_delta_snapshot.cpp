@@ -0,0 +1,257 @@
+#include "doctest.h"
+#include "engine/ecs/BitStream.h"
+#include "engine/ecs/DeltaSnapshot.h"
+#include "game/components/GameComponents.h"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+constexpr float POSITION_PRECISION = 0.01f;
+
+void registerComponents(engine::World& world) {
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::Velocity>();
+    world.registerComponent<game::Enemy>();
+}
+
+engine::ReplicationSchema makeSchema() {
+    engine::ReplicationSchema schema;
+    schema.add<game::Transform>({POSITION_PRECISION, POSITION_PRECISION, 0.001f});
+    schema.add<game::Velocity>(); // Bit-exact
+    schema.add<game::Enemy>();
+    return schema;
+}
+
+// Checks that every replicated entity in `source` has a matching entity in `target`
+void checkReplica(engine::World& source, engine::World& target,
+                  const engine::DeltaDecoder& decoder, const std::vector<engine::EntityId>& alive) {
+    for (engine::EntityId entity : alive) {
+        engine::EntityId local = decoder.toLocal(entity);
+        REQUIRE(target.isAlive(local));
+        const auto& expected = source.readComponent<game::Transform>(entity);
+        const auto& actual = target.readComponent<game::Transform>(local);
+        CHECK(std::fabs(actual.x - expected.x) <= POSITION_PRECISION * 0.5f + 1e-4f);
+        CHECK(std::fabs(actual.y - expected.y) <= POSITION_PRECISION * 0.5f + 1e-4f);
+
+        CHECK(target.hasComponent<game::Velocity>(local) ==
+              source.hasComponent<game::Velocity>(entity));
+        if (source.hasComponent<game::Velocity>(entity)) {
+            const auto& velocity = target.readComponent<game::Velocity>(local);
+            CHECK(velocity.vx == source.readComponent<game::Velocity>(entity).vx);
+            CHECK(velocity.vy == source.readComponent<game::Velocity>(entity).vy);
+        }
+        CHECK(target.hasComponent<game::Enemy>(local) == source.hasComponent<game::Enemy>(entity));
+    }
+    CHECK(target.getLivingEntityCount() == alive.size());
+}
+
+// Runs a scripted simulation through an encoder/decoder pair
+void runRoundTrip(bool tracked) {
+    engine::World source;
+    engine::World target;
+    registerComponents(source);
+    registerComponents(target);
+    if (tracked) {
+        source.enableChangeTracking<game::Transform>();
+        source.enableChangeTracking<game::Velocity>();
+        source.enableChangeTracking<game::Enemy>();
+    }
+
+    engine::ReplicationSchema schema = makeSchema();
+    engine::DeltaEncoder encoder(schema);
+    engine::DeltaDecoder decoder(schema);
+
+    std::vector<engine::EntityId> alive;
+    for (int i = 0; i < 200; ++i) {
+        engine::EntityId entity = source.createEntity();
+        source.addComponent(entity, game::Transform{float(i) * 1.37f, float(-i) * 0.21f, 0.0f});
+        if (i % 2 == 0) {
+            source.addComponent(entity, game::Velocity{0.1f * float(i), -0.3f});
+        }
+        if (i % 5 == 0) {
+            source.addComponent(entity, game::Enemy{});
+        }
+        alive.push_back(entity);
+    }
+
+    std::vector<std::byte> delta;
+    for (int tick = 0; tick < 20; ++tick) {
+        // Move a few entities, churn components and recycle slots
+        for (size_t i = static_cast<size_t>(tick) % 7; i < alive.size(); i += 7) {
+            auto& transform = source.getComponent<game::Transform>(alive[i]);
+            transform.x += 0.173f;
+            transform.y -= 0.049f * float(tick);
+        }
+        if (tick % 3 == 0) {
+            engine::EntityId victim = alive[static_cast<size_t>(tick) * 5 % alive.size()];
+            source.destroyEntity(victim);
+            alive.erase(std::find(alive.begin(), alive.end(), victim));
+
+            engine::EntityId spawned = source.createEntity();
+            source.addComponent(spawned, game::Transform{-4.0f, float(tick), 1.0f});
+            alive.push_back(spawned);
+        }
+        engine::EntityId toggled = alive[static_cast<size_t>(tick) * 3 % alive.size()];
+        if (source.hasComponent<game::Velocity>(toggled)) {
+            source.removeComponent<game::Velocity>(toggled);
+        } else {
+            source.addComponent(toggled, game::Velocity{1.5f, float(tick)});
+        }
+
+        delta.clear();
+        encoder.encode(source, delta);
+        REQUIRE(decoder.decode(target, delta.data(), delta.size()));
+        checkReplica(source, target, decoder, alive);
+    }
+    CHECK(encoder.getSequence() == 20);
+    CHECK(decoder.getSequence() == 20);
+}
+
+} // namespace
+
+TEST_CASE("BitStream round-trips bits and variable-length integers") {
+    std::vector<std::byte> buffer;
+    {
+        engine::BitWriter writer(buffer);
+        writer.writeBits(5, 3);
+        writer.writeBool(true);
+        writer.writeBits(0xDEADBEEF, 32);
+        for (uint32_t value : {0u, 15u, 16u, 1023u, 1024u, 131071u, 131072u, 0xFFFFFFFFu}) {
+            writer.writeVarUint(value);
+        }
+        for (int32_t value : {0, -1, 1, -70000, 70000, INT32_MIN, INT32_MAX}) {
+            writer.writeVarInt(value);
+        }
+    }
+
+    engine::BitReader reader(buffer.data(), buffer.size());
+    CHECK(reader.readBits(3) == 5);
+    CHECK(reader.readBool());
+    CHECK(reader.readBits(32) == 0xDEADBEEF);
+    for (uint32_t value : {0u, 15u, 16u, 1023u, 1024u, 131071u, 131072u, 0xFFFFFFFFu}) {
+        CHECK(reader.readVarUint() == value);
+    }
+    for (int32_t value : {0, -1, 1, -70000, 70000, INT32_MIN, INT32_MAX}) {
+        CHECK(reader.readVarInt() == value);
+    }
+    CHECK_FALSE(reader.hasFailed());
+
+    reader.readBits(32);
+    reader.readBits(32);
+    CHECK(reader.hasFailed());
+}
+
+TEST_CASE("Delta snapshots replicate creates, destroys and component changes") {
+    SUBCASE("full comparison") {
+        runRoundTrip(false);
+    }
+    SUBCASE("change tracked") {
+        runRoundTrip(true);
+    }
+}
+
+TEST_CASE("Delta snapshots of an unchanged World are tiny") {
+    engine::World source;
+    engine::World target;
+    registerComponents(source);
+    registerComponents(target);
+    source.enableChangeTracking<game::Transform>();
+    source.enableChangeTracking<game::Velocity>();
+    source.enableChangeTracking<game::Enemy>();
+
+    for (int i = 0; i < 1000; ++i) {
+        engine::EntityId entity = source.createEntity();
+        source.addComponent(entity, game::Transform{float(i), 0.0f, 0.0f});
+        source.addComponent(entity, game::Velocity{1.0f, 0.0f});
+    }
+
+    engine::ReplicationSchema schema = makeSchema();
+    engine::DeltaEncoder encoder(schema);
+    engine::DeltaDecoder decoder(schema);
+
+    std::vector<std::byte> full;
+    encoder.encode(source, full);
+    REQUIRE(decoder.decode(target, full.data(), full.size()));
+
+    std::vector<std::byte> empty;
+    encoder.encode(source, empty);
+    CHECK(empty.size() <= 5); // Sequence number and end marker
+    REQUIRE(decoder.decode(target, empty.data(), empty.size()));
+
+    // One moved entity costs a handful of bytes, not a full record
+    source.getComponent<game::Transform>(source.getEntityAt(500)).x += 1.0f;
+    std::vector<std::byte> single;
+    encoder.encode(source, single);
+    CHECK(single.size() < 16);
+    CHECK(single.size() * 50 < full.size());
+    REQUIRE(decoder.decode(target, single.data(), single.size()));
+
+    engine::EntityId local = decoder.toLocal(source.getEntityAt(500));
+    CHECK(target.readComponent<game::Transform>(local).x == doctest::Approx(501.0f));
+}
+
+TEST_CASE("Delta decoder rejects out-of-order and truncated input") {
+    engine::World source;
+    registerComponents(source);
+    for (int i = 0; i < 50; ++i) {
+        engine::EntityId entity = source.createEntity();
+        source.addComponent(entity, game::Transform{float(i), float(i), 0.0f});
+    }
+
+    engine::ReplicationSchema schema = makeSchema();
+    engine::DeltaEncoder encoder(schema);
+    std::vector<std::byte> first;
+    std::vector<std::byte> second;
+    encoder.encode(source, first);
+    source.getComponent<game::Transform>(source.getEntityAt(3)).y = 10.0f;
+    encoder.encode(source, second);
+
+    SUBCASE("skipped delta") {
+        engine::World target;
+        registerComponents(target);
+        engine::DeltaDecoder decoder(schema);
+        CHECK_FALSE(decoder.decode(target, second.data(), second.size()));
+        CHECK(decoder.getSequence() == 0);
+    }
+
+    SUBCASE("truncated delta") {
+        engine::World target;
+        registerComponents(target);
+        engine::DeltaDecoder decoder(schema);
+        CHECK_FALSE(decoder.decode(target, first.data(), first.size() / 2));
+        CHECK_FALSE(decoder.decode(target, first.data(), 2));
+    }
+}
+
+TEST_CASE("Change tracking marks mutable access only") {
+    engine::World world;
+    registerComponents(world);
+    world.enableChangeTracking<game::Transform>();
+    engine::ComponentTypeId transformType = engine::getComponentTypeId<game::Transform>();
+    CHECK(world.isChangeTracked(transformType));
+    CHECK_FALSE(world.isChangeTracked(engine::getComponentTypeId<game::Velocity>()));
+
+    engine::EntityId entity = world.createEntity();
+    world.addComponent(entity, game::Transform{});
+    uint32_t index = engine::entityIndex(entity);
+    CHECK(world.getChangedTick(transformType, index) == world.getChangeTick());
+
+    world.advanceChangeTick();
+    uint32_t tick = world.getChangeTick();
+    (void)world.readComponent<game::Transform>(entity);
+    world.view<const game::Transform>().each([](engine::EntityId, const game::Transform&) {});
+    CHECK(world.getChangedTick(transformType, index) < tick);
+
+    world.view<game::Transform>().each([](engine::EntityId, game::Transform&) {});
+    CHECK(world.getChangedTick(transformType, index) == tick);
+
+    world.advanceChangeTick();
+    world.getComponent<game::Transform>(entity).x = 1.0f;
+    CHECK(world.getChangedTick(transformType, index) == world.getChangeTick());
+
+    world.advanceChangeTick();
+    world.destroyEntity(entity);
+    CHECK(world.getChangedTick(transformType, index) == world.getChangeTick());
+}
@@ -0,0 +1,241 @@
+#include "doctest.h"
+#include "engine/core/InputRecorder.h"
+#include "engine/core/MappedFile.h"
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+namespace {
+
+// Deterministic input pattern with long idle stretches and short bursts
+game::PlayerInput inputAt(size_t frame) {
+    if ((frame / 100) % 3 == 0) {
+        return game::PlayerInput{};
+    }
+    return engine::InputRecorder::UnpackInput(static_cast<uint8_t>((frame / 7) % 64));
+}
+
+bool sameInput(const game::PlayerInput& a, const game::PlayerInput& b) {
+    return engine::InputRecorder::PackInput(a) == engine::InputRecorder::PackInput(b);
+}
+
+size_t fileSize(const char* filename) {
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    return static_cast<size_t>(file.tellg());
+}
+
+} // namespace
+
+TEST_CASE("InputRecorder packs every input combination into one byte") {
+    for (uint32_t bits = 0; bits < 64; ++bits) {
+        game::PlayerInput input = engine::InputRecorder::UnpackInput(static_cast<uint8_t>(bits));
+        CHECK(engine::InputRecorder::PackInput(input) == bits);
+    }
+}
+
+TEST_CASE("InputRecorder streams a recording to disk and back") {
+    const char* filename = "test_input_recorder.bin";
+    constexpr size_t FRAMES = 20000;
+    {
+        engine::InputRecorder recorder;
+        recorder.StartRecording(filename, 30, engine::makeEntityId(7, 2));
+        REQUIRE(recorder.GetState() == engine::InputRecorder::State::RECORDING);
+        for (size_t frame = 0; frame < FRAMES; ++frame) {
+            game::PlayerInput input = inputAt(frame);
+            CHECK_FALSE(recorder.ProcessInput(input));
+        }
+        CHECK(recorder.GetFrameCount() == FRAMES);
+        recorder.StopRecording();
+    }
+
+    // Runs of identical frames collapse to a couple of bytes each; the seek
+    // index adds 16 bytes per 256 frames
+    CHECK(fileSize(filename) < FRAMES / 3);
+
+    engine::InputRecorder player;
+    player.StartPlayback(filename);
+    REQUIRE(player.GetState() == engine::InputRecorder::State::PLAYBACK);
+    CHECK(player.GetTickRate() == 30);
+    CHECK(player.GetEntity() == engine::makeEntityId(7, 2));
+    CHECK(player.GetFrameCount() == FRAMES);
+
+    bool matches = true;
+    for (size_t frame = 0; frame < FRAMES; ++frame) {
+        game::PlayerInput input;
+        matches = matches && player.ProcessInput(input) && sameInput(input, inputAt(frame));
+    }
+    CHECK(matches);
+
+    game::PlayerInput extra;
+    CHECK_FALSE(player.ProcessInput(extra));
+    CHECK(player.GetState() == engine::InputRecorder::State::IDLE);
+
+    std::remove(filename);
+}
+
+TEST_CASE("InputRecorder plays back recordings that were cut short") {
+    const char* filename = "test_input_recorder_cut.bin";
+    {
+        engine::InputRecorder recorder;
+        recorder.StartRecording(filename);
+        for (size_t frame = 0; frame < 500; ++frame) {
+            game::PlayerInput input = inputAt(frame);
+            recorder.ProcessInput(input);
+        }
+        recorder.StopRecording();
+    }
+
+    // Zero the frame count as if the recorder never got to patch it
+    {
+        std::fstream file(filename, std::ios::binary | std::ios::in | std::ios::out);
+        file.seekp(12);
+        const char zeros[8] = {};
+        file.write(zeros, sizeof(zeros));
+    }
+
+    engine::InputRecorder player;
+    player.StartPlayback(filename);
+    REQUIRE(player.GetState() == engine::InputRecorder::State::PLAYBACK);
+    CHECK(player.GetFrameCount() == 0);
+    CHECK_FALSE(player.CanSeek());
+
+    size_t played = 0;
+    game::PlayerInput input;
+    while (player.ProcessInput(input)) {
+        played++;
+    }
+    CHECK(played == 500);
+
+    // Drop the footer too, as if the recorder never got to write it
+    {
+        std::ifstream file(filename, std::ios::binary);
+        std::vector<char> bytes((std::istreambuf_iterator<char>(file)),
+                                std::istreambuf_iterator<char>());
+        uint64_t footer = 0;
+        for (size_t i = 0; i < 8; ++i) {
+            footer |= static_cast<uint64_t>(static_cast<uint8_t>(bytes[bytes.size() - 12 + i]))
+                      << (8 * i);
+        }
+        file.close();
+        std::ofstream truncated(filename, std::ios::binary | std::ios::trunc);
+        truncated.write(bytes.data(), static_cast<std::streamsize>(footer));
+    }
+
+    player.StartPlayback(filename);
+    REQUIRE(player.GetState() == engine::InputRecorder::State::PLAYBACK);
+    played = 0;
+    while (player.ProcessInput(input)) {
+        played++;
+    }
+    CHECK(played == 500);
+
+    std::remove(filename);
+}
+
+TEST_CASE("InputRecorder rejects files that are not recordings") {
+    const char* filename = "test_input_recorder_bad.bin";
+    {
+        // The old format: a raw size_t frame count followed by PlayerInput structs
+        std::ofstream file(filename, std::ios::binary);
+        size_t count = 1;
+        game::PlayerInput input;
+        file.write(reinterpret_cast<const char*>(&count), sizeof(count));
+        file.write(reinterpret_cast<const char*>(&input), sizeof(input));
+    }
+
+    engine::InputRecorder player;
+    player.StartPlayback(filename);
+    CHECK(player.GetState() == engine::InputRecorder::State::IDLE);
+
+    player.StartPlayback("does_not_exist.bin");
+    CHECK(player.GetState() == engine::InputRecorder::State::IDLE);
+
+    std::remove(filename);
+}
+
+TEST_CASE("InputRecorder seeks to any frame through the footer index") {
+    const char* filename = "test_input_recorder_seek.bin";
+    constexpr size_t FRAMES = 5000;
+    {
+        engine::InputRecorder recorder;
+        recorder.StartRecording(filename);
+        for (size_t frame = 0; frame < FRAMES; ++frame) {
+            if (frame % 1000 == 0) {
+                // Stand-in for a World snapshot: the frame number itself
+                std::vector<std::byte> snapshot(8);
+                for (size_t i = 0; i < snapshot.size(); ++i) {
+                    snapshot[i] = static_cast<std::byte>(frame >> (8 * i));
+                }
+                recorder.AddKeyframe(snapshot);
+            }
+            game::PlayerInput input = inputAt(frame);
+            recorder.ProcessInput(input);
+        }
+        recorder.StopRecording();
+    }
+
+    engine::InputRecorder player;
+    player.StartPlayback(filename);
+    REQUIRE(player.GetState() == engine::InputRecorder::State::PLAYBACK);
+    REQUIRE(player.CanSeek());
+    CHECK(player.GetKeyframeCount() == 5);
+
+    for (uint64_t target : {4999u, 0u, 256u, 1000u, 1337u, 2303u, 17u}) {
+        REQUIRE(player.SeekToFrame(target));
+        CHECK(player.GetCurrentFrame() == target);
+        bool matches = true;
+        for (uint64_t frame = target; frame < std::min<uint64_t>(target + 300, FRAMES); ++frame) {
+            game::PlayerInput input;
+            matches = matches && player.ProcessInput(input) && sameInput(input, inputAt(frame));
+        }
+        CHECK(matches);
+    }
+    CHECK_FALSE(player.SeekToFrame(FRAMES + 1));
+
+    engine::InputKeyframe keyframe;
+    REQUIRE(player.FindKeyframe(2999, keyframe));
+    CHECK(keyframe.frame == 2000);
+    REQUIRE(keyframe.size == 8);
+    uint64_t stored = 0;
+    for (size_t i = 0; i < keyframe.size; ++i) {
+        stored |= static_cast<uint64_t>(keyframe.data[i]) << (8 * i);
+    }
+    CHECK(stored == 2000);
+    REQUIRE(player.FindKeyframe(4999, keyframe));
+    CHECK(keyframe.frame == 4000);
+
+    // Linear playback steps over the keyframes
+    REQUIRE(player.SeekToFrame(0));
+    size_t played = 0;
+    bool matches = true;
+    game::PlayerInput input;
+    while (player.ProcessInput(input)) {
+        matches = matches && sameInput(input, inputAt(played));
+        played++;
+    }
+    CHECK(matches);
+    CHECK(played == FRAMES);
+
+    std::remove(filename);
+}
+
+TEST_CASE("MappedFile exposes file contents") {
+    const char* filename = "test_mapped_file.bin";
+    {
+        std::ofstream file(filename, std::ios::binary);
+        file << "mapped";
+    }
+
+    engine::MappedFile mapped;
+    REQUIRE(mapped.open(filename));
+    REQUIRE(mapped.size() == 6);
+    CHECK(static_cast<char>(mapped.data()[0]) == 'm');
+    CHECK(static_cast<char>(mapped.data()[5]) == 'd');
+    mapped.close();
+    CHECK_FALSE(mapped.isOpen());
+    CHECK_FALSE(mapped.open("does_not_exist.bin"));
+
+    std::remove(filename);
+}
@@ -1,5 +1,15 @@
 #include "doctest.h"
 #include "engine/core/Logger.h"
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <limits>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
 
 TEST_CASE("Logger System") {
     SUBCASE("Initialization") {
@@ -22,3 +32,336 @@ TEST_CASE("Logger System") {
         CHECK(true);
     }
 }
+
+namespace {
+
+std::vector<std::string> readLines(const std::string& path) {
+    std::vector<std::string> lines;
+    std::ifstream in(path);
+    for (std::string line; std::getline(in, line);) {
+        lines.push_back(line);
+    }
+    return lines;
+}
+
+std::string logPath(const char* name) {
+    std::string path = std::string("test_logger_") + name + ".log";
+    std::remove(path.c_str());
+    return path;
+}
+
+} // namespace
+
+// Records that tests count are logged at ERROR, which every ENGINE_LOG_MIN_LEVEL
+// keeps
+
+TEST_CASE("Logger async mode") {
+    engine::LoggerConfig config;
+    config.async = true;
+    config.console = false;
+    config.overflow = engine::LogOverflow::BLOCK;
+
+    SUBCASE("Writes every record in order") {
+        config.filePath = logPath("ordered");
+        config.queueCapacity = 16; // Forces producers to wait on the writer
+        engine::Logger::Init(config);
+        for (int i = 0; i < 1000; ++i) {
+            engine::Logger::Error("record ", i);
+        }
+        engine::Logger::Flush();
+
+        std::vector<std::string> lines = readLines(config.filePath);
+        REQUIRE(lines.size() == 1000);
+        for (int i = 0; i < 1000; ++i) {
+            std::string expected = "[ERROR] record " + std::to_string(i);
+            CHECK(lines[i].size() > expected.size());
+            CHECK(lines[i].compare(lines[i].size() - expected.size(), expected.size(),
+                                   expected) == 0);
+        }
+        CHECK(lines[0].find('\033') == std::string::npos);
+        engine::Logger::Shutdown();
+        std::remove(config.filePath.c_str());
+    }
+
+    SUBCASE("Several producers") {
+        config.filePath = logPath("producers");
+        engine::Logger::Init(config);
+        constexpr int THREADS = 4;
+        constexpr int PER_THREAD = 500;
+        std::vector<std::thread> threads;
+        for (int t = 0; t < THREADS; ++t) {
+            threads.emplace_back([t] {
+                for (int i = 0; i < PER_THREAD; ++i) {
+                    engine::Logger::Error("thread ", t, " line ", i);
+                }
+            });
+        }
+        for (std::thread& thread : threads) {
+            thread.join();
+        }
+        engine::Logger::Shutdown(); // Drains before returning
+
+        std::vector<std::string> lines = readLines(config.filePath);
+        REQUIRE(lines.size() == THREADS * PER_THREAD);
+        // Each producer's records keep their relative order
+        std::vector<int> next(THREADS, 0);
+        for (const std::string& line : lines) {
+            size_t at = line.find("thread ");
+            REQUIRE(at != std::string::npos);
+            int thread = 0;
+            int index = 0;
+            REQUIRE(std::sscanf(line.c_str() + at, "thread %d line %d", &thread, &index) == 2);
+            CHECK(index == next[thread]);
+            next[thread] = index + 1;
+        }
+        std::remove(config.filePath.c_str());
+    }
+
+    SUBCASE("Drop policy counts what it discards") {
+        config.filePath = logPath("drop");
+        config.overflow = engine::LogOverflow::DROP;
+        config.queueCapacity = 4;
+        engine::Logger::Init(config);
+        for (int i = 0; i < 10000; ++i) {
+            engine::Logger::Error("burst ", i);
+        }
+        engine::Logger::Flush();
+        uint64_t dropped = engine::Logger::GetDroppedCount();
+        engine::Logger::Shutdown();
+
+        // Every record is either written or counted, plus drop notices
+        std::vector<std::string> lines = readLines(config.filePath);
+        size_t written = 0;
+        uint64_t reported = 0;
+        for (const std::string& line : lines) {
+            unsigned long long count = 0;
+            size_t at = line.find("Logger dropped ");
+            if (at != std::string::npos) {
+                std::sscanf(line.c_str() + at, "Logger dropped %llu", &count);
+                reported += count;
+            } else {
+                written++;
+            }
+        }
+        CHECK(dropped > 0);
+        CHECK(written + dropped == 10000);
+        CHECK(reported == dropped);
+        std::remove(config.filePath.c_str());
+    }
+
+    SUBCASE("Long messages are truncated") {
+        config.filePath = logPath("long");
+        engine::Logger::Init(config);
+        engine::Logger::Error(std::string(1000, 'x'));
+        engine::Logger::Shutdown();
+
+        std::vector<std::string> lines = readLines(config.filePath);
+        REQUIRE(lines.size() == 1);
+        CHECK(lines[0].size() < 300);
+        CHECK(lines[0].compare(lines[0].size() - 4, 4, "x...") == 0);
+        std::remove(config.filePath.c_str());
+    }
+
+    SUBCASE("Shutdown returns to synchronous output") {
+        config.filePath = logPath("shutdown");
+        engine::Logger::Init(config);
+        engine::Logger::Error("queued");
+        engine::Logger::Shutdown();
+        engine::Logger::Info("Back on the console");
+        CHECK(readLines(config.filePath).size() == 1);
+        std::remove(config.filePath.c_str());
+    }
+}
+
+TEST_CASE("Logger writes long messages whole when synchronous") {
+    engine::LoggerConfig config;
+    config.console = false;
+    config.filePath = logPath("long_sync");
+    engine::Logger::Init(config);
+    engine::Logger::Error(std::string(1000, 'x'));
+    // Formatted past LogMessage's inline buffer
+    engine::Logger::Error(std::string(200, 'a'), 12345, std::string(200, 'b'));
+    engine::Logger::Shutdown();
+
+    std::vector<std::string> lines = readLines(config.filePath);
+    REQUIRE(lines.size() == 2);
+    std::string expected = "[ERROR] " + std::string(1000, 'x');
+    CHECK(lines[0].compare(lines[0].size() - expected.size(), expected.size(), expected) == 0);
+    expected = std::string(200, 'a') + "12345" + std::string(200, 'b');
+    CHECK(lines[1].compare(lines[1].size() - expected.size(), expected.size(), expected) == 0);
+    std::remove(config.filePath.c_str());
+}
+
+TEST_CASE("Logger can be reconfigured while other threads log") {
+    engine::LoggerConfig config;
+    config.console = false;
+    config.filePath = logPath("reconfigure");
+    config.overflow = engine::LogOverflow::BLOCK;
+    config.queueCapacity = 16;
+    engine::Logger::Init(config);
+
+    std::atomic<bool> done{false};
+    std::atomic<int> logged{0};
+    std::vector<std::thread> threads;
+    for (int t = 0; t < 3; ++t) {
+        threads.emplace_back([&] {
+            while (!done.load()) {
+                engine::Logger::Error("line ", logged.fetch_add(1));
+            }
+        });
+    }
+    // Every switch closes the queue while producers are pushing to it
+    for (int i = 0; i < 40; ++i) {
+        config.async = i % 2 == 1;
+        engine::Logger::Init(config);
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    done = true;
+    for (std::thread& thread : threads) {
+        thread.join();
+    }
+    engine::Logger::Shutdown();
+
+    // Nothing was lost or written twice
+    std::vector<std::string> lines = readLines(config.filePath);
+    CHECK(lines.size() == static_cast<size_t>(logged.load()));
+    std::vector<bool> seen(static_cast<size_t>(logged.load()), false);
+    bool unique = true;
+    for (const std::string& line : lines) {
+        size_t at = line.find("line ");
+        REQUIRE(at != std::string::npos);
+        size_t index = std::stoul(line.substr(at + 5));
+        REQUIRE(index < seen.size());
+        unique = unique && !seen[index];
+        seen[index] = true;
+    }
+    CHECK(unique);
+    std::remove(config.filePath.c_str());
+}
+
+namespace {
+
+// Counts how often it is formatted
+struct Expensive {
+    int* formatted;
+};
+
+std::ostream& operator<<(std::ostream& stream, const Expensive& value) {
+    ++*value.formatted;
+    return stream << "expensive";
+}
+
+template<typename... Args>
+std::string format(const Args&... args) {
+    engine::LogMessage message;
+    engine::Logger::FormatTo(message, args...);
+    return std::string(message.view());
+}
+
+template<typename... Args>
+std::string streamed(const Args&... args) {
+    std::ostringstream stream;
+    (stream << ... << args);
+    return stream.str();
+}
+
+} // namespace
+
+TEST_CASE("Logger formatting and levels") {
+    SUBCASE("Formats like a stream") {
+        int value = -42;
+        const char* text = "text";
+        std::string owned = "owned";
+        int formatted = 0;
+        CHECK(format("int=", value, " uint=", 7u, " u64=", UINT64_MAX, " i64=", INT64_MIN) ==
+              streamed("int=", value, " uint=", 7u, " u64=", UINT64_MAX, " i64=", INT64_MIN));
+        CHECK(format(3.14f, ' ', 0.1, ' ', 1e20, ' ', -0.0f, ' ', 123456789.0) ==
+              streamed(3.14f, ' ', 0.1, ' ', 1e20, ' ', -0.0f, ' ', 123456789.0));
+        double inf = std::numeric_limits<double>::infinity();
+        CHECK(format(inf, ' ', -inf, ' ', 1e-300, ' ', 5e-324) ==
+              streamed(inf, ' ', -inf, ' ', 1e-300, ' ', 5e-324));
+        CHECK(format(text, owned, std::string_view("view"), 'c', true, false) ==
+              streamed(text, owned, std::string_view("view"), 'c', true, false));
+        CHECK(format(uint8_t('A'), int8_t('b')) == streamed(uint8_t('A'), int8_t('b')));
+        CHECK(format(Expensive{&formatted}) == "expensive");
+        CHECK(format(static_cast<const char*>(nullptr)) == "(null)");
+        CHECK(format(static_cast<void*>(nullptr)) == "0");
+        CHECK(format(static_cast<void*>(&value)) == streamed(static_cast<void*>(&value)));
+    }
+
+    SUBCASE("Long messages move to the heap") {
+        std::string longText(300, 'y');
+        CHECK(format("start ", longText, " end", 5) == "start " + longText + " end5");
+        CHECK(format(std::string(256, 'z')) == std::string(256, 'z'));
+    }
+
+    SUBCASE("Runtime threshold skips formatting") {
+        int formatted = 0;
+        engine::Logger::SetLevel(engine::LogLevel::WARN);
+        CHECK_FALSE(engine::Logger::IsEnabled(engine::LogLevel::INFO));
+        CHECK(engine::Logger::IsEnabled(engine::LogLevel::ERROR));
+        engine::Logger::Debug("Hidden ", Expensive{&formatted});
+        engine::Logger::Info("Hidden ", Expensive{&formatted});
+        CHECK(formatted == 0);
+        engine::Logger::Error("Shown ", Expensive{&formatted});
+        CHECK(formatted == 1);
+        engine::Logger::SetLevel(engine::LogLevel::DEBUG);
+    }
+
+    SUBCASE("Init applies the configured level") {
+        engine::LoggerConfig config;
+        config.level = engine::LogLevel::ERROR;
+        config.console = false;
+        config.filePath = logPath("level");
+        engine::Logger::Init(config);
+        CHECK(engine::Logger::GetLevel() == engine::LogLevel::ERROR);
+        engine::Logger::Warn("dropped");
+        engine::Logger::Log(engine::LogLevel::INFO, "dropped too");
+        engine::Logger::Error("kept");
+        engine::Logger::Shutdown();
+        CHECK(engine::Logger::GetLevel() == engine::LogLevel::DEBUG);
+
+        std::vector<std::string> lines = readLines(config.filePath);
+        REQUIRE(lines.size() == 1);
+        CHECK(lines[0].find("kept") != std::string::npos);
+        std::remove(config.filePath.c_str());
+    }
+}
+
+TEST_CASE("Logger compiles out levels below ENGINE_LOG_MIN_LEVEL") {
+    // Builds configured with -DENGINE_LOG_MIN_LEVEL=INFO or higher exercise
+    // the compiled-out calls; the runtime threshold lets everything through
+    engine::LoggerConfig config;
+    config.console = false;
+    config.filePath = logPath("compiled");
+    engine::Logger::Init(config);
+
+    int evaluated = 0;
+    int formatted = 0;
+    auto argument = [&] {
+        ++evaluated;
+        return Expensive{&formatted};
+    };
+    engine::Logger::Debug("DEBUG ", argument());
+    engine::Logger::Info("INFO ", argument());
+    engine::Logger::Warn("WARN ", argument());
+    engine::Logger::Error("ERROR ", argument());
+    engine::Logger::Shutdown();
+
+    const char* names[] = {"DEBUG ", "INFO ", "WARN ", "ERROR "};
+    const int compiledOut = ENGINE_LOG_MIN_LEVEL;
+    CHECK(evaluated == 4);
+    CHECK(formatted == 4 - compiledOut);
+    std::vector<std::string> lines = readLines(config.filePath);
+    REQUIRE(lines.size() == static_cast<size_t>(4 - compiledOut));
+    for (int level = 0; level < 4; ++level) {
+        bool compiledIn = level >= compiledOut;
+        CHECK(engine::Logger::IsEnabled(static_cast<engine::LogLevel>(level)) == compiledIn);
+        if (compiledIn) {
+            std::string expected = std::string(names[level]) + "expensive";
+            const std::string& line = lines[level - compiledOut];
+            CHECK(line.compare(line.size() - expected.size(), expected.size(), expected) == 0);
+        }
+    }
+    std::remove(config.filePath.c_str());
+}
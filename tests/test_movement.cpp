@@ -0,0 +1,107 @@
+#include "doctest.h"
+#include "engine/systems/MovementSystem.h"
+#include <cstring>
+#include <random>
+
+namespace {
+
+bool sameBits(float a, float b) {
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+// MovementSystem's original per-entity logic, used as reference
+void referenceUpdate(engine::World& world, float dt) {
+    world.view<game::Transform, game::Velocity>().each(
+        [&](engine::EntityId entity, game::Transform& transform, game::Velocity& velocity) {
+        if (world.hasComponent<game::PreviousTransform>(entity)) {
+            auto& prev = world.getComponent<game::PreviousTransform>(entity);
+            prev.x = transform.x;
+            prev.y = transform.y;
+            prev.rotation = transform.rotation;
+        }
+        transform.x += velocity.vx * dt;
+        transform.y += velocity.vy * dt;
+        const float worldSize = 0.9f;
+        if (transform.x < -worldSize) transform.x = -worldSize;
+        if (transform.x > worldSize) transform.x = worldSize;
+        if (transform.y < -worldSize) transform.y = -worldSize;
+        if (transform.y > worldSize) transform.y = worldSize;
+    });
+}
+
+void populate(engine::World& world, unsigned seed) {
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::PreviousTransform>();
+    world.registerComponent<game::Velocity>();
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-1.2f, 1.2f);
+    std::uniform_real_distribution<float> speed(-3.0f, 3.0f);
+    for (int i = 0; i < 1001; ++i) {
+        engine::EntityId entity = world.createEntity();
+        world.addComponent(entity, game::Transform{position(rng), position(rng), speed(rng)});
+        if (i % 5 != 0) {
+            world.addComponent(entity, game::Velocity{speed(rng), speed(rng)});
+        }
+        if (i % 3 != 0) {
+            world.addComponent(entity, game::PreviousTransform{0.0f, 0.0f, 0.0f});
+        }
+    }
+}
+
+} // namespace
+
+TEST_CASE("MovementSystem matches the per-entity reference") {
+    engine::World expected;
+    engine::World actual;
+    populate(expected, 3);
+    populate(actual, 3);
+
+    engine::ThreadPool pool(2);
+    engine::MovementSystem system(&pool);
+    for (int tick = 0; tick < 30; ++tick) {
+        referenceUpdate(expected, 1.0f / 60.0f);
+        system.update(actual, 1.0f / 60.0f);
+    }
+
+    bool identical = true;
+    expected.view<game::Transform>().each([&](engine::EntityId entity, game::Transform& transform) {
+        const auto& other = actual.getComponent<game::Transform>(entity);
+        identical = identical && sameBits(transform.x, other.x) && sameBits(transform.y, other.y);
+        if (expected.hasComponent<game::PreviousTransform>(entity)) {
+            const auto& prev = expected.getComponent<game::PreviousTransform>(entity);
+            const auto& otherPrev = actual.getComponent<game::PreviousTransform>(entity);
+            identical = identical && sameBits(prev.x, otherPrev.x) &&
+                        sameBits(prev.y, otherPrev.y) && prev.rotation == otherPrev.rotation;
+        }
+    });
+    CHECK(identical);
+}
+
+TEST_CASE("MovementSystem leaves Velocity change stamps alone") {
+    engine::World world;
+    populate(world, 5);
+    world.enableChangeTracking<game::Transform>();
+    world.enableChangeTracking<game::Velocity>();
+    engine::ComponentTypeId transformType = engine::getComponentTypeId<game::Transform>();
+    engine::ComponentTypeId velocityType = engine::getComponentTypeId<game::Velocity>();
+
+    engine::ThreadPool pool(2);
+    engine::MovementSystem serial;
+    engine::MovementSystem parallel(&pool);
+    for (engine::MovementSystem* system : {&serial, &parallel}) {
+        uint32_t tick = world.advanceChangeTick();
+        system->update(world, 1.0f / 60.0f);
+
+        bool velocityUntouched = true;
+        bool transformStamped = true;
+        world.view<const game::Velocity>().each(
+            [&](engine::EntityId entity, const game::Velocity&) {
+            uint32_t index = engine::entityIndex(entity);
+            velocityUntouched &= world.getChangedTick(velocityType, index) < tick;
+            transformStamped &= world.getChangedTick(transformType, index) == tick;
+        });
+        CHECK(velocityUntouched);
+        CHECK(transformStamped);
+    }
+}
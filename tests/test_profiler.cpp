@@ -0,0 +1,149 @@
+#include "doctest.h"
+#include "engine/core/Profiler.h"
+#include "engine/core/Simulation.h"
+#include "engine/systems/MovementSystem.h"
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <memory>
+#include <string>
+
+namespace {
+
+size_t countOf(const std::string& text, const std::string& pattern) {
+    size_t count = 0;
+    for (size_t at = text.find(pattern); at != std::string::npos;
+         at = text.find(pattern, at + 1)) {
+        count++;
+    }
+    return count;
+}
+
+} // namespace
+
+TEST_CASE("Profiler") {
+    engine::Profiler profiler;
+
+    SUBCASE("Sections are found by name") {
+        uint32_t a = profiler.addSection("A");
+        uint32_t b = profiler.addSection("B");
+        CHECK(a != b);
+        CHECK(profiler.addSection("A") == a);
+    }
+
+    SUBCASE("Stats of the samples since the last collect") {
+        uint32_t section = profiler.addSection("Work");
+        profiler.addSection("Idle");
+        for (int ms = 1; ms <= 100; ++ms) {
+            profiler.record(section, 1000, 1000 + ms * 1000000ll);
+        }
+
+        std::vector<engine::ProfileStats> stats = profiler.collect();
+        REQUIRE(stats.size() == 1); // Idle has no samples
+        CHECK(stats[0].name == "Work");
+        CHECK(stats[0].count == 100);
+        CHECK(stats[0].minMs == doctest::Approx(1.0));
+        CHECK(stats[0].avgMs == doctest::Approx(50.5));
+        CHECK(stats[0].p99Ms == doctest::Approx(99.0));
+        CHECK(stats[0].maxMs == doctest::Approx(100.0));
+        CHECK(profiler.collect().empty());
+
+        profiler.record(section, 0, 2000000);
+        stats = profiler.collect();
+        REQUIRE(stats.size() == 1);
+        CHECK(stats[0].count == 1);
+        CHECK(stats[0].p99Ms == doctest::Approx(2.0));
+    }
+
+    SUBCASE("Sample memory is bounded between collects") {
+        // Durations 1..N us, shuffled by a stride coprime to N
+        uint32_t section = profiler.addSection("Busy");
+        const int64_t total = static_cast<int64_t>(engine::Profiler::MAX_SAMPLES) * 8;
+        for (int64_t i = 0; i < total; ++i) {
+            int64_t us = (i * 7919) % total + 1;
+            profiler.record(section, 0, us * 1000);
+        }
+
+        std::vector<engine::ProfileStats> stats = profiler.collect();
+        REQUIRE(stats.size() == 1);
+        CHECK(stats[0].count == total);
+        CHECK(stats[0].minMs == doctest::Approx(0.001));
+        CHECK(stats[0].maxMs == doctest::Approx(total / 1000.0));
+        CHECK(stats[0].avgMs == doctest::Approx((total + 1) / 2000.0));
+        // Estimated from the reservoir: within half a percent of the exact rank
+        double exactP99Ms = total * 0.99 / 1000.0;
+        CHECK(stats[0].p99Ms > exactP99Ms * 0.995);
+        CHECK(stats[0].p99Ms < exactP99Ms * 1.005);
+
+        // Counters start over after a collect
+        profiler.record(section, 0, 3000000);
+        stats = profiler.collect();
+        REQUIRE(stats.size() == 1);
+        CHECK(stats[0].count == 1);
+        CHECK(stats[0].minMs == doctest::Approx(3.0));
+        CHECK(stats[0].avgMs == doctest::Approx(3.0));
+        CHECK(stats[0].p99Ms == doctest::Approx(3.0));
+    }
+
+    SUBCASE("Scopes only time while enabled") {
+        uint32_t section = profiler.addSection("Scoped");
+        { engine::ProfileScope scope(&profiler, section); }
+        CHECK(profiler.collect().empty());
+
+        profiler.setEnabled(true);
+        { engine::ProfileScope scope(&profiler, section); }
+        { engine::ProfileScope scope(nullptr, section); }
+        std::vector<engine::ProfileStats> stats = profiler.collect();
+        REQUIRE(stats.size() == 1);
+        CHECK(stats[0].count == 1);
+        CHECK(stats[0].minMs >= 0.0);
+    }
+
+    SUBCASE("Chrome trace") {
+        const std::string path = "test_profiler_trace.json";
+        uint32_t section = profiler.addSection("Quote\"d");
+        profiler.record(section, 0, 500); // Before tracing: not in the trace
+        profiler.startTrace(3);
+        CHECK(profiler.isTracing());
+        for (int i = 0; i < 5; ++i) {
+            profiler.record(section, i * 1000, i * 1000 + 1500);
+        }
+        REQUIRE(profiler.writeTrace(path));
+        CHECK_FALSE(profiler.isTracing());
+
+        std::ifstream in(path);
+        std::string json((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+        CHECK(json.rfind("{\"displayTimeUnit\":\"ms\"", 0) == 0);
+        CHECK(countOf(json, "\"ph\":\"X\"") == 3);
+        CHECK(countOf(json, "\"name\":\"Quote\\\"d\"") == 3);
+        CHECK(json.find("\"droppedEvents\":2") != std::string::npos);
+        CHECK(json.find("\"ts\":1.000,\"dur\":1.500") != std::string::npos);
+        CHECK(json.find("]}") != std::string::npos);
+        std::remove(path.c_str());
+    }
+}
+
+TEST_CASE("Simulation profiles ticks and systems") {
+    engine::Simulation simulation(0);
+    simulation.addSystem(std::make_unique<engine::MovementSystem>());
+    engine::World& world = simulation.getWorld();
+    engine::EntityId entity = world.createEntity();
+    world.addComponent(entity, game::Transform{});
+    world.addComponent(entity, game::PreviousTransform{});
+    world.addComponent(entity, game::Velocity{1.0f, 0.0f});
+
+    simulation.update(1.0f / 60.0f);
+    CHECK(simulation.getProfiler().collect().empty()); // Disabled by default
+
+    simulation.getProfiler().setEnabled(true);
+    for (int i = 0; i < 3; ++i) {
+        simulation.update(1.0f / 60.0f);
+    }
+    std::vector<engine::ProfileStats> stats = simulation.getProfiler().collect();
+    REQUIRE(stats.size() == 2);
+    CHECK(stats[0].name == "Tick");
+    CHECK(stats[0].count == 3);
+    CHECK(stats[1].name == "MovementSystem");
+    CHECK(stats[1].count == 3);
+    CHECK(stats[1].avgMs <= stats[0].avgMs);
+}
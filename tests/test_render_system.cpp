@@ -0,0 +1,198 @@
+#include "doctest.h"
+#include "engine/systems/RenderSystem.h"
+#include <algorithm>
+#include <vector>
+
+// Built with ENGINE_NULL_RENDERER, so updates need no GL context
+
+namespace {
+
+struct Queued {
+    engine::EntityId entity;
+    int layer;
+    float x, y;
+};
+
+std::vector<engine::EntityId> sorted(std::vector<engine::EntityId> entities) {
+    std::sort(entities.begin(), entities.end());
+    return entities;
+}
+
+struct RenderFixture {
+    engine::World world;
+    Renderer renderer;
+    engine::RenderSystem system{renderer};
+
+    RenderFixture() {
+        world.registerComponent<game::Transform>();
+        world.registerComponent<game::PreviousTransform>();
+        world.registerComponent<game::Renderable>();
+    }
+
+    engine::EntityId spawn(float x, int layer) {
+        engine::EntityId entity = world.createEntity();
+        world.addComponent(entity, game::Transform{x, 0.0f, 0.0f});
+        game::Renderable renderable{};
+        renderable.r = renderable.g = renderable.b = 1.0f;
+        renderable.width = renderable.height = 0.1f;
+        renderable.layer = layer;
+        world.addComponent(entity, renderable);
+        return entity;
+    }
+
+    std::vector<Queued> update() {
+        system.update(world, 1.0f);
+        std::vector<Queued> queue;
+        system.forEachQueued([&](engine::EntityId entity, int layer, float x, float y) {
+            queue.push_back({entity, layer, x, y});
+        });
+        CHECK(queue.size() == system.getQueuedCount());
+        return queue;
+    }
+
+    std::vector<engine::EntityId> layerEntities(const std::vector<Queued>& queue, int layer) {
+        std::vector<engine::EntityId> entities;
+        for (const auto& entry : queue) {
+            if (entry.layer == layer) {
+                entities.push_back(entry.entity);
+            }
+        }
+        return sorted(entities);
+    }
+};
+
+bool inLayerOrder(const std::vector<Queued>& queue) {
+    for (size_t i = 1; i < queue.size(); ++i) {
+        if (queue[i - 1].layer > queue[i].layer) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+TEST_CASE("RenderSystem queues entities in layer order") {
+    RenderFixture fixture;
+    fixture.spawn(0.0f, 2);
+    fixture.spawn(0.1f, 0);
+    fixture.spawn(0.2f, 1);
+    fixture.spawn(0.3f, 0);
+
+    auto queue = fixture.update();
+    CHECK(queue.size() == 4);
+    CHECK(fixture.system.getLayerCount() == 3);
+    CHECK(inLayerOrder(queue));
+    CHECK(fixture.renderer.GetDrawCallCount() == 1);
+    CHECK(fixture.renderer.GetBatchedVertexCount() == 0); // Flushed at the end
+}
+
+TEST_CASE("RenderSystem moves an entity that changes layer") {
+    RenderFixture fixture;
+    engine::EntityId a = fixture.spawn(0.0f, 0);
+    engine::EntityId b = fixture.spawn(0.1f, 0);
+    engine::EntityId c = fixture.spawn(0.2f, 1);
+    fixture.update();
+
+    fixture.world.getComponent<game::Renderable>(a).layer = 5;
+    auto queue = fixture.update();
+    CHECK(queue.size() == 3);
+    CHECK(inLayerOrder(queue));
+    CHECK(fixture.layerEntities(queue, 0) == std::vector<engine::EntityId>{b});
+    CHECK(fixture.layerEntities(queue, 1) == std::vector<engine::EntityId>{c});
+    CHECK(fixture.layerEntities(queue, 5) == std::vector<engine::EntityId>{a});
+    CHECK(queue.back().entity == a);
+
+    // A new layer below the others shifts every bucket
+    fixture.world.getComponent<game::Renderable>(c).layer = -1;
+    queue = fixture.update();
+    CHECK(queue.front().entity == c);
+    CHECK(inLayerOrder(queue));
+    CHECK(fixture.layerEntities(queue, 5) == std::vector<engine::EntityId>{a});
+}
+
+TEST_CASE("RenderSystem swap-remove keeps the moved entry's slot") {
+    RenderFixture fixture;
+    for (int i = 0; i < 3; ++i) {
+        fixture.spawn(0.1f * i, 0);
+    }
+
+    // Removing the layer's first entry moves its last entry into that place
+    auto queue = fixture.update();
+    engine::EntityId removed = queue[0].entity;
+    engine::EntityId moved = queue[2].entity;
+    engine::EntityId kept = queue[1].entity;
+    fixture.world.destroyEntity(removed);
+    queue = fixture.update();
+    CHECK(queue.size() == 2);
+    CHECK(queue[0].entity == moved);
+    CHECK(fixture.layerEntities(queue, 0) == sorted({moved, kept}));
+
+    // Both survivors must still find their own entries: positions update in
+    // place and a layer change removes the right one
+    fixture.world.getComponent<game::Transform>(moved).x = 0.5f;
+    fixture.world.getComponent<game::Transform>(kept).x = 0.7f;
+    queue = fixture.update();
+    REQUIRE(queue.size() == 2);
+    CHECK(queue[0].entity == moved);
+    CHECK(queue[0].x == 0.5f);
+    CHECK(queue[1].entity == kept);
+    CHECK(queue[1].x == 0.7f);
+
+    fixture.world.getComponent<game::Renderable>(moved).layer = 1;
+    queue = fixture.update();
+    CHECK(fixture.layerEntities(queue, 0) == std::vector<engine::EntityId>{kept});
+    CHECK(fixture.layerEntities(queue, 1) == std::vector<engine::EntityId>{moved});
+}
+
+TEST_CASE("RenderSystem sweeps entities that stop rendering") {
+    RenderFixture fixture;
+    std::vector<engine::EntityId> entities;
+    for (int i = 0; i < 6; ++i) {
+        entities.push_back(fixture.spawn(0.1f * i, i % 2));
+    }
+    fixture.update();
+    REQUIRE(fixture.system.getQueuedCount() == 6);
+
+    fixture.world.destroyEntity(entities[0]);
+    fixture.world.destroyEntity(entities[3]);
+    fixture.world.removeComponent<game::Renderable>(entities[4]);
+    auto queue = fixture.update();
+    CHECK(queue.size() == 3);
+    CHECK(fixture.layerEntities(queue, 0) == std::vector<engine::EntityId>{entities[2]});
+    CHECK(fixture.layerEntities(queue, 1) == sorted({entities[1], entities[5]}));
+    CHECK(inLayerOrder(queue));
+
+    for (engine::EntityId entity : {entities[1], entities[2], entities[5]}) {
+        fixture.world.destroyEntity(entity);
+    }
+    CHECK(fixture.update().empty());
+    CHECK(fixture.system.getQueuedCount() == 0);
+}
+
+TEST_CASE("RenderSystem replaces an entity whose index is reused") {
+    RenderFixture fixture;
+    engine::EntityId a = fixture.spawn(0.0f, 0);
+    engine::EntityId b = fixture.spawn(0.1f, 0);
+    fixture.update();
+
+    // Destroyed and reused within one frame: the queue never sees a gap
+    fixture.world.destroyEntity(a);
+    engine::EntityId reused = fixture.spawn(0.3f, 2);
+    REQUIRE(engine::entityIndex(reused) == engine::entityIndex(a));
+    REQUIRE(reused != a);
+
+    auto queue = fixture.update();
+    CHECK(queue.size() == 2);
+    CHECK(fixture.layerEntities(queue, 0) == std::vector<engine::EntityId>{b});
+    CHECK(fixture.layerEntities(queue, 2) == std::vector<engine::EntityId>{reused});
+    CHECK(queue.back().x == 0.3f);
+
+    // Same layer as before, this time
+    fixture.world.destroyEntity(reused);
+    engine::EntityId again = fixture.spawn(0.4f, 0);
+    REQUIRE(engine::entityIndex(again) == engine::entityIndex(a));
+    queue = fixture.update();
+    CHECK(queue.size() == 2);
+    CHECK(fixture.layerEntities(queue, 0) == sorted({b, again}));
+}
@@ -0,0 +1,100 @@
+#include "doctest.h"
+#include "engine/platform/Renderer.h"
+#include <cmath>
+
+// Built with ENGINE_NULL_RENDERER: batches are inspected instead of drawn
+
+TEST_CASE("Renderer batches quads as four vertices and two triangles") {
+    Renderer renderer;
+    renderer.Clear();
+    renderer.RenderRectangle(0.5f, -0.5f, 0.2f, 0.4f, 1.0f, 0.0f, 0.5f);
+    renderer.RenderRectangle(0.0f, 0.0f, 1.0f, 1.0f, 0.0f, 1.0f, 0.0f);
+
+    REQUIRE(renderer.GetBatchedVertexCount() == 8);
+    REQUIRE(renderer.GetBatchedIndexCount() == 12);
+
+    const auto& vertices = renderer.GetBatchedVertices();
+    CHECK(vertices[0].x == doctest::Approx(0.4f));
+    CHECK(vertices[0].y == doctest::Approx(-0.7f));
+    CHECK(vertices[2].x == doctest::Approx(0.6f));
+    CHECK(vertices[2].y == doctest::Approx(-0.3f));
+    CHECK(vertices[0].r == 255);
+    CHECK(vertices[0].g == 0);
+    CHECK(vertices[0].b == 128);
+    CHECK(vertices[0].a == 255);
+
+    // The second quad indexes its own vertices
+    const auto& indices = renderer.GetBatchedIndices();
+    const uint32_t expected[12] = {0, 1, 2, 0, 2, 3, 4, 5, 6, 4, 6, 7};
+    for (size_t i = 0; i < 12; ++i) {
+        CHECK(indices[i] == expected[i]);
+    }
+}
+
+TEST_CASE("Renderer batches circles as a triangle fan") {
+    Renderer renderer;
+    renderer.Clear();
+    renderer.RenderRectangle(0.0f, 0.0f, 0.1f, 0.1f, 1.0f, 1.0f, 1.0f);
+    renderer.RenderCircle(0.25f, 0.5f, 0.1f, 0.0f, 0.0f, 1.0f);
+
+    const size_t rim = Renderer::CIRCLE_SEGMENTS;
+    REQUIRE(renderer.GetBatchedVertexCount() == 4 + rim + 1);
+    REQUIRE(renderer.GetBatchedIndexCount() == 6 + rim * 3);
+
+    const auto& vertices = renderer.GetBatchedVertices();
+    const auto& indices = renderer.GetBatchedIndices();
+    CHECK(vertices[4].x == 0.25f);
+    CHECK(vertices[4].y == 0.5f);
+    CHECK(vertices[5].x == doctest::Approx(0.35f));
+    CHECK(vertices[5].y == doctest::Approx(0.5f));
+    bool onRim = true;
+    for (size_t i = 5; i < vertices.size(); ++i) {
+        float distance = std::hypot(vertices[i].x - 0.25f, vertices[i].y - 0.5f);
+        onRim = onRim && std::fabs(distance - 0.1f) < 1e-5f;
+    }
+    CHECK(onRim);
+
+    // Every triangle joins the centre to two neighbouring rim vertices, the
+    // last one wrapping around to the first
+    bool fan = true;
+    for (uint32_t i = 0; i < rim; ++i) {
+        const uint32_t* triangle = &indices[6 + i * 3];
+        fan = fan && triangle[0] == 4 && triangle[1] == 5 + i &&
+              triangle[2] == 5 + (i + 1) % rim;
+    }
+    CHECK(fan);
+}
+
+TEST_CASE("Renderer flushes a full batch early and keeps submission order") {
+    Renderer renderer;
+    renderer.Clear();
+
+    size_t quads = Renderer::MAX_BATCH_VERTICES / 4;
+    for (size_t i = 0; i < quads; ++i) {
+        renderer.RenderRectangle(0.0f, 0.0f, 0.1f, 0.1f, 1.0f, 0.0f, 0.0f);
+    }
+    CHECK(renderer.GetBatchedVertexCount() == Renderer::MAX_BATCH_VERTICES);
+    CHECK(renderer.GetDrawCallCount() == 0);
+
+    // No room for the circle: everything before it is drawn first, and the
+    // circle starts the next batch at vertex 0
+    renderer.RenderCircle(0.0f, 0.0f, 0.1f, 0.0f, 1.0f, 0.0f);
+    CHECK(renderer.GetDrawCallCount() == 1);
+    REQUIRE(renderer.GetBatchedVertexCount() == Renderer::CIRCLE_SEGMENTS + 1);
+    CHECK(renderer.GetBatchedIndices().front() == 0);
+    CHECK(renderer.GetBatchedVertices().front().g == 255);
+
+    renderer.RenderRectangle(0.0f, 0.0f, 0.1f, 0.1f, 0.0f, 0.0f, 1.0f);
+    CHECK(renderer.GetBatchedIndices().back() == Renderer::CIRCLE_SEGMENTS + 4);
+
+    renderer.Flush();
+    CHECK(renderer.GetDrawCallCount() == 2);
+    CHECK(renderer.GetBatchedVertexCount() == 0);
+    CHECK(renderer.GetBatchedIndexCount() == 0);
+
+    // Nothing batched: no draw call
+    renderer.Flush();
+    CHECK(renderer.GetDrawCallCount() == 2);
+    renderer.Clear();
+    CHECK(renderer.GetDrawCallCount() == 0);
+}
@@ -0,0 +1,124 @@
+#include "doctest.h"
+#include "engine/ecs/Scheduler.h"
+#include "game/components/GameComponents.h"
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+// Writes one component type from a read-only source; records when it ran
+class CopySystem : public engine::System {
+public:
+    CopySystem(std::vector<int>& order, int id, engine::SystemAccess access)
+        : order(order), id(id), access(access) {}
+
+    void update(engine::World& world, float dt) override {
+        if (access.writes.test(engine::getComponentTypeId<game::Transform>())) {
+            world.view<game::Transform, game::Velocity>().each(
+                [dt](engine::EntityId, game::Transform& transform, game::Velocity& velocity) {
+                transform.x += velocity.vx * dt;
+            });
+        }
+        std::lock_guard<std::mutex> lock(orderMutex());
+        order.push_back(id);
+    }
+
+    engine::SystemAccess getAccess() const override { return access; }
+
+    static std::mutex& orderMutex() {
+        static std::mutex mutex;
+        return mutex;
+    }
+
+private:
+    std::vector<int>& order;
+    int id;
+    engine::SystemAccess access;
+};
+
+} // namespace
+
+TEST_CASE("Scheduler stages") {
+    engine::ThreadPool pool(2);
+    engine::Scheduler scheduler(pool);
+    std::vector<int> order;
+
+    auto transformRW = engine::SystemAccess{engine::componentSignature<game::Velocity>(),
+                                            engine::componentSignature<game::Transform>()};
+    auto velocityRead = engine::SystemAccess{engine::componentSignature<game::Velocity>(),
+                                             engine::Signature()};
+    auto inputWrite = engine::SystemAccess{engine::Signature(),
+                                           engine::componentSignature<game::PlayerInput>()};
+
+    SUBCASE("Readers of the same component share a stage") {
+        scheduler.addSystem(std::make_unique<CopySystem>(order, 0, velocityRead));
+        scheduler.addSystem(std::make_unique<CopySystem>(order, 1, inputWrite));
+        scheduler.addSystem(std::make_unique<CopySystem>(order, 2, velocityRead));
+        CHECK(scheduler.getStageCount() == 1);
+    }
+
+    SUBCASE("Conflicting systems keep registration order") {
+        scheduler.addSystem(std::make_unique<CopySystem>(order, 0, velocityRead));
+        scheduler.addSystem(std::make_unique<CopySystem>(order, 1, transformRW));
+        scheduler.addSystem(std::make_unique<CopySystem>(order, 2, transformRW));
+        scheduler.addSystem(std::make_unique<CopySystem>(order, 3, inputWrite));
+        // {0, 1, 3} then {2}: 1 and 2 both write Transform
+        CHECK(scheduler.getStageCount() == 2);
+
+        engine::World world;
+        world.registerComponent<game::Transform>();
+        world.registerComponent<game::Velocity>();
+        engine::EntityId entity = world.createEntity();
+        world.addComponent(entity, game::Transform{0.0f, 0.0f, 0.0f});
+        world.addComponent(entity, game::Velocity{1.0f, 0.0f});
+
+        scheduler.update(world, 0.5f);
+        REQUIRE(order.size() == 4);
+        CHECK(order.back() == 2);
+        CHECK(world.getComponent<game::Transform>(entity).x == 1.0f);
+    }
+
+    SUBCASE("Undeclared access runs exclusively") {
+        engine::SystemAccess exclusive;
+        exclusive.exclusive = true;
+        scheduler.addSystem(std::make_unique<CopySystem>(order, 0, velocityRead));
+        scheduler.addSystem(std::make_unique<CopySystem>(order, 1, exclusive));
+        scheduler.addSystem(std::make_unique<CopySystem>(order, 2, velocityRead));
+        CHECK(scheduler.getStageCount() == 3);
+    }
+}
+
+TEST_CASE("ThreadPool runs every task") {
+    for (size_t workers : {0u, 1u, 4u}) {
+        engine::ThreadPool pool(workers);
+        engine::TaskGroup group;
+        std::atomic<int> counter{0};
+        for (int i = 0; i < 1000; ++i) {
+            pool.submit(group, [&counter] { counter++; });
+        }
+        pool.wait(group);
+        CHECK(counter == 1000);
+    }
+}
+
+TEST_CASE("ThreadPool parallelFor covers every index once, including nested") {
+    engine::ThreadPool pool(3);
+    std::vector<std::atomic<int>> hits(10000);
+
+    pool.parallelFor(100, 7, [&](size_t begin, size_t end) {
+        for (size_t outer = begin; outer < end; ++outer) {
+            pool.parallelFor(100, 16, [&](size_t innerBegin, size_t innerEnd) {
+                for (size_t inner = innerBegin; inner < innerEnd; ++inner) {
+                    hits[outer * 100 + inner]++;
+                }
+            });
+        }
+    });
+
+    bool allOnce = true;
+    for (auto& hit : hits) {
+        allOnce = allOnce && hit == 1;
+    }
+    CHECK(allOnce);
+}
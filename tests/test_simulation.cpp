@@ -0,0 +1,204 @@
+#include "doctest.h"
+#include "engine/core/Simulation.h"
+#include "engine/systems/MovementSystem.h"
+#include "engine/systems/PlaybackInputSystem.h"
+#include "engine/systems/PlayerControl.h"
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+engine::EntityId addPlayer(engine::World& world) {
+    engine::EntityId player = world.createEntity();
+    world.addComponent(player, game::Transform{0.0f, 0.0f, 0.0f});
+    world.addComponent(player, game::PreviousTransform{0.0f, 0.0f, 0.0f});
+    world.addComponent(player, game::Velocity{0.0f, 0.0f});
+    world.addComponent(player, game::PlayerInput{});
+    return player;
+}
+
+std::vector<game::Transform> runScene(size_t workerCount) {
+    engine::Simulation simulation(workerCount);
+    simulation.addSystem(std::make_unique<engine::PlaybackInputSystem>());
+    simulation.addSystem(std::make_unique<engine::MovementSystem>(
+        &simulation.getThreadPool(), &simulation.getSpatialGrid()));
+
+    auto& world = simulation.getWorld();
+    std::vector<engine::EntityId> entities;
+    for (int i = 0; i < 5000; ++i) {
+        engine::EntityId entity = world.createEntity();
+        world.addComponent(entity, game::Transform{(i % 100) * 0.018f - 0.9f, 0.1f, 0.0f});
+        world.addComponent(entity, game::Velocity{(i % 7) * 0.1f - 0.3f, (i % 5) * 0.1f - 0.2f});
+        entities.push_back(entity);
+    }
+    for (int tick = 0; tick < 120; ++tick) {
+        simulation.update(1.0f / 60.0f);
+    }
+    CHECK(simulation.getTickCount() == 120);
+
+    std::vector<game::Transform> transforms;
+    for (engine::EntityId entity : entities) {
+        transforms.push_back(world.getComponent<game::Transform>(entity));
+    }
+    return transforms;
+}
+
+} // namespace
+
+TEST_CASE("Simulation is deterministic across worker counts") {
+    auto serial = runScene(0);
+    auto parallel = runScene(3);
+    REQUIRE(serial.size() == parallel.size());
+
+    bool identical = true;
+    for (size_t i = 0; i < serial.size(); ++i) {
+        identical = identical && serial[i].x == parallel[i].x && serial[i].y == parallel[i].y;
+    }
+    CHECK(identical);
+}
+
+TEST_CASE("PlaybackInputSystem replays recorded input") {
+    const char* filename = "test_playback_input.bin";
+    {
+        engine::InputRecorder recorder;
+        recorder.StartRecording(filename);
+        game::PlayerInput input;
+        input.moveRight = true;
+        recorder.ProcessInput(input);
+        input.moveRight = false;
+        input.moveUp = true;
+        recorder.ProcessInput(input);
+        recorder.StopRecording();
+    }
+
+    engine::Simulation simulation(0);
+    auto& playback = static_cast<engine::PlaybackInputSystem&>(
+        simulation.addSystem(std::make_unique<engine::PlaybackInputSystem>(filename)));
+    engine::EntityId player = addPlayer(simulation.getWorld());
+    CHECK(playback.isPlaying());
+
+    auto& velocity = simulation.getWorld().getComponent<game::Velocity>(player);
+    simulation.update(1.0f / 60.0f);
+    CHECK(velocity.vx > 0.0f);
+    CHECK(velocity.vy == 0.0f);
+
+    simulation.update(1.0f / 60.0f);
+    CHECK(velocity.vx == 0.0f);
+    CHECK(velocity.vy > 0.0f);
+
+    // Out of frames: playback stops and the last input is kept
+    simulation.update(1.0f / 60.0f);
+    CHECK_FALSE(playback.isPlaying());
+    CHECK(velocity.vy > 0.0f);
+
+    std::remove(filename);
+}
+
+TEST_CASE("PlaybackInputSystem stamps input and velocity only when they change") {
+    const char* filename = "test_playback_stamps.bin";
+    {
+        engine::InputRecorder recorder;
+        recorder.StartRecording(filename);
+        game::PlayerInput input;
+        input.moveRight = true;
+        recorder.ProcessInput(input);
+        recorder.ProcessInput(input);
+        input.moveUp = true;
+        recorder.ProcessInput(input);
+        recorder.StopRecording();
+    }
+
+    engine::Simulation simulation(0);
+    simulation.addSystem(std::make_unique<engine::PlaybackInputSystem>(filename));
+    engine::World& world = simulation.getWorld();
+    engine::EntityId player = addPlayer(world);
+    world.enableChangeTracking<game::PlayerInput>();
+    world.enableChangeTracking<game::Velocity>();
+    uint32_t index = engine::entityIndex(player);
+    auto inputTick = [&] {
+        return world.getChangedTick(engine::getComponentTypeId<game::PlayerInput>(), index);
+    };
+    auto velocityTick = [&] {
+        return world.getChangedTick(engine::getComponentTypeId<game::Velocity>(), index);
+    };
+
+    uint32_t tick = world.advanceChangeTick();
+    simulation.update(1.0f / 60.0f);
+    CHECK(inputTick() == tick);
+    CHECK(velocityTick() == tick);
+
+    // Same input as last tick
+    tick = world.advanceChangeTick();
+    simulation.update(1.0f / 60.0f);
+    CHECK(inputTick() < tick);
+    CHECK(velocityTick() < tick);
+
+    tick = world.advanceChangeTick();
+    simulation.update(1.0f / 60.0f);
+    CHECK(inputTick() == tick);
+    CHECK(velocityTick() == tick);
+    CHECK(world.readComponent<game::Velocity>(player).vy > 0.0f);
+
+    // Playback has ended and the input is kept as it is
+    tick = world.advanceChangeTick();
+    simulation.update(1.0f / 60.0f);
+    CHECK(inputTick() < tick);
+    CHECK(velocityTick() < tick);
+
+    std::remove(filename);
+}
+
+TEST_CASE("PlaybackInputSystem seeks through recorded keyframes") {
+    const char* filename = "test_playback_seek.bin";
+    constexpr uint64_t FRAMES = 400;
+    auto inputAt = [](uint64_t frame) {
+        return engine::InputRecorder::UnpackInput(static_cast<uint8_t>((frame / 13) % 16));
+    };
+
+    // Record a session, keyframing the World every 100 frames
+    game::Transform expected{};
+    {
+        engine::Simulation simulation(0);
+        simulation.addSystem(std::make_unique<engine::MovementSystem>());
+        engine::EntityId player = addPlayer(simulation.getWorld());
+        engine::World& world = simulation.getWorld();
+
+        engine::InputRecorder recorder;
+        recorder.StartRecording(filename, 60, player);
+        std::vector<std::byte> keyframe;
+        for (uint64_t frame = 0; frame < FRAMES; ++frame) {
+            if (frame % 100 == 0) {
+                keyframe.clear();
+                world.saveSnapshot(keyframe);
+                recorder.AddKeyframe(keyframe);
+            }
+            game::PlayerInput input = inputAt(frame);
+            recorder.ProcessInput(input);
+            engine::applyPlayerInput(input, world.getComponent<game::Velocity>(player));
+            simulation.update(1.0f / 60.0f);
+        }
+        recorder.StopRecording();
+        expected = world.getComponent<game::Transform>(player);
+    }
+
+    // Jump close to the end and simulate only the remainder
+    engine::Simulation simulation(0);
+    auto& playback = static_cast<engine::PlaybackInputSystem&>(
+        simulation.addSystem(std::make_unique<engine::PlaybackInputSystem>(filename)));
+    simulation.addSystem(std::make_unique<engine::MovementSystem>());
+    engine::EntityId player = addPlayer(simulation.getWorld());
+
+    uint64_t keyframeFrame = 0;
+    REQUIRE(playback.seekToKeyframe(simulation.getWorld(), 350, keyframeFrame));
+    CHECK(keyframeFrame == 300);
+    CHECK(playback.getRecorder().GetCurrentFrame() == 300);
+    for (uint64_t frame = keyframeFrame; frame < FRAMES; ++frame) {
+        simulation.update(1.0f / 60.0f);
+    }
+
+    const auto& transform = simulation.getWorld().getComponent<game::Transform>(player);
+    CHECK(transform.x == expected.x);
+    CHECK(transform.y == expected.y);
+
+    std::remove(filename);
+}
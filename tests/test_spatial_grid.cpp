@@ -0,0 +1,113 @@
+#include "doctest.h"
+#include "engine/ecs/SpatialGrid.h"
+#include "engine/systems/MovementSystem.h"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+namespace {
+
+struct Point {
+    engine::EntityId entity;
+    float x, y, halfSize;
+};
+
+std::vector<Point> randomPoints(size_t count, unsigned seed) {
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<float> position(-1.2f, 1.2f); // Some fall outside the grid
+    std::uniform_real_distribution<float> size(0.0f, 0.05f);
+    std::vector<Point> points;
+    for (size_t i = 0; i < count; ++i) {
+        points.push_back({engine::makeEntityId(static_cast<uint32_t>(i), 0), position(rng),
+                          position(rng), size(rng)});
+    }
+    return points;
+}
+
+} // namespace
+
+TEST_CASE("SpatialGrid queries match brute force") {
+    engine::SpatialGrid grid(-1.0f, -1.0f, 1.0f, 1.0f, 0.1f);
+    auto points = randomPoints(2000, 11);
+    grid.clear();
+    for (const auto& p : points) {
+        grid.insert(p.entity, p.x, p.y, p.x - p.halfSize, p.y - p.halfSize, p.x + p.halfSize,
+                    p.y + p.halfSize);
+    }
+    grid.build();
+    CHECK(grid.size() == points.size());
+    CHECK(grid.contains(points[5].entity));
+    CHECK_FALSE(grid.contains(engine::makeEntityId(5, 1)));
+
+    SUBCASE("Range") {
+        std::vector<engine::EntityId> found;
+        grid.queryRange(-0.3f, 0.1f, 0.25f, 0.6f, found);
+
+        std::vector<engine::EntityId> expected;
+        for (const auto& p : points) {
+            if (p.x + p.halfSize >= -0.3f && p.x - p.halfSize <= 0.25f &&
+                p.y + p.halfSize >= 0.1f && p.y - p.halfSize <= 0.6f) {
+                expected.push_back(p.entity);
+            }
+        }
+        std::sort(found.begin(), found.end());
+        std::sort(expected.begin(), expected.end());
+        CHECK(found == expected);
+    }
+
+    SUBCASE("Nearest") {
+        std::mt19937 rng(5);
+        std::uniform_real_distribution<float> position(-1.0f, 1.0f);
+        bool allMatch = true;
+        for (int i = 0; i < 200; ++i) {
+            float x = position(rng), y = position(rng);
+            float bestDistance = 1e9f;
+            for (const auto& p : points) {
+                bestDistance = std::min(bestDistance, (p.x - x) * (p.x - x) + (p.y - y) * (p.y - y));
+            }
+            engine::EntityId found = grid.nearest(x, y);
+            const auto& p = points[engine::entityIndex(found)];
+            allMatch = allMatch && (p.x - x) * (p.x - x) + (p.y - y) * (p.y - y) == bestDistance;
+        }
+        CHECK(allMatch);
+        CHECK(grid.nearest(0.0f, 0.0f, 0.0f) == engine::INVALID_ENTITY);
+    }
+}
+
+TEST_CASE("MovementSystem keeps the spatial grid current") {
+    engine::World world;
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::PreviousTransform>();
+    world.registerComponent<game::Velocity>();
+    world.registerComponent<game::Renderable>();
+
+    engine::EntityId mover = world.createEntity();
+    world.addComponent(mover, game::Transform{0.0f, 0.0f, 0.0f});
+    world.addComponent(mover, game::PreviousTransform{0.0f, 0.0f, 0.0f});
+    world.addComponent(mover, game::Velocity{6.0f, 0.0f});
+
+    engine::EntityId wall = world.createEntity();
+    world.addComponent(wall, game::Transform{-0.5f, 0.5f, 0.0f});
+    game::Renderable renderable{};
+    renderable.width = 0.2f;
+    renderable.height = 0.2f;
+    world.addComponent(wall, renderable);
+
+    engine::SpatialGrid grid(-1.0f, -1.0f, 1.0f, 1.0f, 0.1f);
+    engine::MovementSystem system(nullptr, &grid);
+    system.update(world, 0.1f);
+
+    CHECK(grid.size() == 2);
+    CHECK(grid.nearest(0.55f, 0.0f) == mover);
+    CHECK(grid.nearest(-0.5f, 0.4f) == wall);
+
+    // Box is swept from the previous position (0, 0) to (0.6, 0)
+    std::vector<engine::EntityId> found;
+    grid.queryRange(0.2f, -0.05f, 0.3f, 0.05f, found);
+    CHECK(found == std::vector<engine::EntityId>{mover});
+
+    // Renderable extents widen the static entity's box
+    found.clear();
+    grid.queryRange(-0.45f, 0.45f, -0.42f, 0.48f, found);
+    CHECK(found == std::vector<engine::EntityId>{wall});
+}
@@ -0,0 +1,181 @@
+#include "doctest.h"
+#include "engine/ecs/World.h"
+#include "game/components/GameComponents.h"
+#include <cstring>
+#include <vector>
+
+namespace {
+
+void registerComponents(engine::World& world) {
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::Velocity>();
+    world.registerComponent<game::Enemy>();
+}
+
+void enableHashing(engine::World& world) {
+    world.enableStateHash<game::Transform>();
+    world.enableStateHash<game::Velocity>();
+    world.enableStateHash<game::Enemy>();
+}
+
+// Hash of the same state computed from scratch, through a snapshot copy
+uint64_t freshHash(const engine::World& world) {
+    std::vector<std::byte> snapshot;
+    world.saveSnapshot(snapshot);
+    engine::World copy;
+    registerComponents(copy);
+    REQUIRE(copy.loadSnapshot(snapshot.data(), snapshot.size()));
+    enableHashing(copy);
+    return copy.getStateHash();
+}
+
+} // namespace
+
+TEST_CASE("hashBytes matches XXH64") {
+    CHECK(engine::hashBytes("", 0) == 0xEF46DB3751D8E999ull);
+    CHECK(engine::hashBytes("abc", 3) == 0x44BC2CF5AD770999ull);
+
+    // Long inputs take the four-lane path; every byte must matter
+    std::vector<unsigned char> bytes(100);
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] = static_cast<unsigned char>(i * 7);
+    }
+    uint64_t original = engine::hashBytes(bytes.data(), bytes.size(), 5);
+    bool allMatter = true;
+    for (size_t i = 0; i < bytes.size(); ++i) {
+        bytes[i] ^= 1;
+        allMatter = allMatter && engine::hashBytes(bytes.data(), bytes.size(), 5) != original;
+        bytes[i] ^= 1;
+    }
+    CHECK(allMatter);
+    CHECK(engine::hashBytes(bytes.data(), bytes.size(), 6) != original);
+}
+
+TEST_CASE("State hash does not depend on storage order") {
+    engine::World first;
+    engine::World second;
+    registerComponents(first);
+    registerComponents(second);
+    enableHashing(first);
+    enableHashing(second);
+
+    std::vector<engine::EntityId> entities;
+    for (int i = 0; i < 10; ++i) {
+        entities.push_back(first.createEntity());
+        second.createEntity();
+    }
+    // Same components, added in opposite orders
+    for (int i = 0; i < 10; ++i) {
+        first.addComponent(entities[i], game::Transform{float(i), 1.0f, 0.0f});
+        first.addComponent(entities[i], game::Velocity{0.5f, float(-i)});
+    }
+    for (int i = 9; i >= 0; --i) {
+        second.addComponent(entities[i], game::Velocity{0.5f, float(-i)});
+        second.addComponent(entities[i], game::Transform{float(i), 1.0f, 0.0f});
+    }
+    CHECK(first.getStateHash() == second.getStateHash());
+    CHECK(first.getStateHash() != 0);
+
+    // Changing a value changes the hash; restoring it restores the hash
+    uint64_t before = first.getStateHash();
+    first.getComponent<game::Transform>(entities[3]).y = 2.0f;
+    CHECK(first.getStateHash() != before);
+    first.getComponent<game::Transform>(entities[3]).y = 1.0f;
+    CHECK(first.getStateHash() == before);
+
+    // Tags count, as does which entity a value belongs to
+    first.addComponent(entities[0], game::Enemy{});
+    CHECK(first.getStateHash() != before);
+    first.removeComponent<game::Enemy>(entities[0]);
+    CHECK(first.getStateHash() == before);
+}
+
+TEST_CASE("Incremental state hash matches a full rehash") {
+    engine::World world;
+    registerComponents(world);
+
+    std::vector<engine::EntityId> entities;
+    for (int i = 0; i < 500; ++i) {
+        engine::EntityId entity = world.createEntity();
+        world.addComponent(entity, game::Transform{float(i), float(i % 7), 0.0f});
+        if (i % 3 == 0) {
+            world.addComponent(entity, game::Velocity{1.0f, -1.0f});
+        }
+        entities.push_back(entity);
+    }
+    // Enabled after entities exist: the first hash must still cover them
+    enableHashing(world);
+    CHECK(world.getStateHash() == freshHash(world));
+
+    for (int tick = 0; tick < 30; ++tick) {
+        world.view<game::Transform, game::Velocity>().each(
+            [](engine::EntityId, game::Transform& transform, game::Velocity& velocity) {
+            transform.x += velocity.vx;
+        });
+        size_t victim = static_cast<size_t>(tick) * 13 % entities.size();
+        if (world.isAlive(entities[victim])) {
+            world.destroyEntity(entities[victim]);
+        }
+        engine::EntityId spawned = world.createEntity();
+        world.addComponent(spawned, game::Transform{-1.0f, float(tick), 0.0f});
+        if (tick % 2 == 0) {
+            world.addComponent(spawned, game::Enemy{});
+        }
+        entities.push_back(spawned);
+
+        // Hash only every few ticks: stamps accumulate in between
+        if (tick % 4 == 3) {
+            CHECK(world.getStateHash() == freshHash(world));
+        }
+    }
+    CHECK(world.getStateHash() == freshHash(world));
+
+    // Read-only access doesn't dirty anything, and clearing empties the hash
+    uint64_t hash = world.getStateHash();
+    world.view<const game::Transform>().each([](engine::EntityId, const game::Transform&) {});
+    CHECK(world.getStateHash() == hash);
+    world.clear();
+    CHECK(world.getStateHash() == 0);
+}
+
+namespace {
+
+// Two copies of the same pair of components. Each copy gets its type IDs
+// in a different first-use order, as two processes might.
+struct ClientPosition { float x, y; };
+struct ClientHealth { int32_t hp; };
+struct ServerPosition { float x, y; };
+struct ServerHealth { int32_t hp; };
+
+template<typename Position, typename Health>
+uint64_t hashOfScene() {
+    engine::World world;
+    world.registerComponent<Position>();
+    world.registerComponent<Health>();
+    world.enableStateHash<Position>();
+    world.enableStateHash<Health>();
+    for (int i = 0; i < 20; ++i) {
+        engine::EntityId entity = world.createEntity();
+        world.addComponent(entity, Position{float(i), -float(i)});
+        if (i % 2 == 0) {
+            world.addComponent(entity, Health{100 - i});
+        }
+    }
+    return world.getStateHash();
+}
+
+} // namespace
+
+TEST_CASE("State hash does not depend on component type IDs") {
+    engine::ComponentTypeId clientPosition = engine::getComponentTypeId<ClientPosition>();
+    engine::ComponentTypeId clientHealth = engine::getComponentTypeId<ClientHealth>();
+    engine::ComponentTypeId serverHealth = engine::getComponentTypeId<ServerHealth>();
+    engine::ComponentTypeId serverPosition = engine::getComponentTypeId<ServerPosition>();
+    REQUIRE(clientPosition < clientHealth);
+    REQUIRE(serverHealth < serverPosition);
+
+    // Registered in the same order, so the hashes agree
+    uint64_t client = hashOfScene<ClientPosition, ClientHealth>();
+    CHECK(client == hashOfScene<ServerPosition, ServerHealth>());
+    CHECK(client != 0);
+}
@@ -0,0 +1,313 @@
+#include "doctest.h"
+#include "engine/ecs/World.h"
+#include "game/components/GameComponents.h"
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+TEST_CASE("ComponentArray sparse set") {
+    engine::ComponentArray<game::Transform> array;
+
+    SUBCASE("Insert and lookup") {
+        array.insertData(3, game::Transform{1.0f, 2.0f, 0.0f});
+        array.insertData(9000, game::Transform{5.0f, 6.0f, 0.0f});
+
+        CHECK(array.size() == 2);
+        CHECK(array.hasData(3));
+        CHECK(array.hasData(9000));
+        CHECK_FALSE(array.hasData(4));
+        CHECK_FALSE(array.hasData(engine::MAX_ENTITIES - 1));
+        CHECK(array.getData(3).x == 1.0f);
+        CHECK(array.getData(9000).y == 6.0f);
+    }
+
+    SUBCASE("Remove keeps remaining components packed and addressable") {
+        for (engine::EntityId entity = 0; entity < 5; ++entity) {
+            array.insertData(entity, game::Transform{static_cast<float>(entity), 0.0f, 0.0f});
+        }
+
+        array.removeData(1);
+        array.entityDestroyed(3);
+        array.entityDestroyed(3); // No-op for entities without the component
+
+        CHECK(array.size() == 3);
+        CHECK_FALSE(array.hasData(1));
+        CHECK_FALSE(array.hasData(3));
+        CHECK(array.getData(0).x == 0.0f);
+        CHECK(array.getData(2).x == 2.0f);
+        CHECK(array.getData(4).x == 4.0f);
+
+        array.insertData(1, game::Transform{10.0f, 0.0f, 0.0f});
+        CHECK(array.getData(1).x == 10.0f);
+    }
+
+    SUBCASE("Removal moves the last component and releases trailing pages") {
+        const engine::EntityId count = 3000; // Three dense pages
+        for (engine::EntityId entity = 0; entity < count; ++entity) {
+            array.insertData(entity, game::Transform{static_cast<float>(entity), 0.0f, 0.0f});
+        }
+
+        // The last component moves into the removed one's slot; the rest stay put
+        game::Transform* removedSlot = &array.getData(0);
+        game::Transform* untouched = &array.getData(1);
+        array.removeData(0);
+        CHECK(&array.getData(count - 1) == removedSlot);
+        CHECK(&array.getData(1) == untouched);
+        CHECK(array.getData(count - 1).x == static_cast<float>(count - 1));
+
+        // Shrinking into the first page frees trailing pages; survivors keep
+        // their values
+        for (engine::EntityId entity = 100; entity < count; ++entity) {
+            array.removeData(entity);
+        }
+        CHECK(array.size() == 99);
+        bool intact = true;
+        for (engine::EntityId entity = 1; entity < 100; ++entity) {
+            intact = intact && array.getData(entity).x == static_cast<float>(entity);
+        }
+        CHECK(intact);
+    }
+}
+
+TEST_CASE("World component management") {
+    engine::World world;
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::Velocity>();
+
+    engine::EntityId a = world.createEntity();
+    engine::EntityId b = world.createEntity();
+    world.addComponent(a, game::Transform{1.0f, 1.0f, 0.0f});
+    world.addComponent(a, game::Velocity{0.5f, 0.0f});
+    world.addComponent(b, game::Transform{2.0f, 2.0f, 0.0f});
+
+    CHECK(world.hasComponent<game::Velocity>(a));
+    CHECK_FALSE(world.hasComponent<game::Velocity>(b));
+    CHECK(world.getSignature(a).count() == 2);
+
+    world.removeComponent<game::Velocity>(a);
+    CHECK_FALSE(world.hasComponent<game::Velocity>(a));
+    CHECK(world.getSignature(a).count() == 1);
+
+    world.destroyEntity(a);
+    CHECK_FALSE(world.hasComponent<game::Transform>(a));
+    CHECK(world.getComponent<game::Transform>(b).x == 2.0f);
+}
+
+TEST_CASE("World view iteration") {
+    engine::World world;
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::Velocity>();
+
+    for (int i = 0; i < 10; ++i) {
+        engine::EntityId entity = world.createEntity();
+        world.addComponent(entity, game::Transform{0.0f, 0.0f, 0.0f});
+        if (i % 3 == 0) {
+            world.addComponent(entity, game::Velocity{1.0f, 2.0f});
+        }
+    }
+
+    SUBCASE("Visits only entities with every component") {
+        int visited = 0;
+        world.view<game::Transform, game::Velocity>().each(
+            [&](engine::EntityId entity, game::Transform& transform, game::Velocity& velocity) {
+            CHECK(world.hasComponent<game::Velocity>(entity));
+            transform.x += velocity.vx;
+            visited++;
+        });
+        CHECK(visited == 4);
+        CHECK(world.getComponent<game::Transform>(0).x == 1.0f);
+        CHECK(world.getComponent<game::Transform>(1).x == 0.0f);
+    }
+
+    SUBCASE("Destroying the current entity during iteration is safe") {
+        int visited = 0;
+        world.view<game::Transform>().each([&](engine::EntityId entity, game::Transform&) {
+            world.destroyEntity(entity);
+            visited++;
+        });
+        CHECK(visited == 10);
+
+        int remaining = 0;
+        world.view<game::Transform>().each([&](engine::EntityId, game::Transform&) { remaining++; });
+        CHECK(remaining == 0);
+    }
+}
+
+TEST_CASE("World grows beyond the old fixed capacity") {
+    engine::World world;
+    world.registerComponent<game::Transform>();
+
+    const uint32_t count = 50000;
+    for (uint32_t i = 0; i < count; ++i) {
+        engine::EntityId entity = world.createEntity();
+        world.addComponent(entity, game::Transform{static_cast<float>(i), 0.0f, 0.0f});
+    }
+    CHECK(world.getLivingEntityCount() == count);
+
+    // References stay valid while other entities gain the same component
+    engine::EntityId first = 0;
+    game::Transform& transform = world.getComponent<game::Transform>(first);
+    for (uint32_t i = 0; i < 5000; ++i) {
+        world.addComponent(world.createEntity(), game::Transform{});
+    }
+    CHECK(&transform == &world.getComponent<game::Transform>(first));
+    CHECK(world.getComponent<game::Transform>(count - 1).x == static_cast<float>(count - 1));
+
+    // Destroyed slots are reused before new ones are minted
+    world.destroyEntity(42);
+    CHECK(engine::entityIndex(world.createEntity()) == 42);
+}
+
+TEST_CASE("Generational entity handles") {
+    engine::World world;
+    world.registerComponent<game::Transform>();
+
+    engine::EntityId old = world.createEntity();
+    world.addComponent(old, game::Transform{1.0f, 0.0f, 0.0f});
+    CHECK(world.isAlive(old));
+
+    world.destroyEntity(old);
+    CHECK_FALSE(world.isAlive(old));
+
+    engine::EntityId reused = world.createEntity();
+    world.addComponent(reused, game::Transform{2.0f, 0.0f, 0.0f});
+
+    CHECK(engine::entityIndex(reused) == engine::entityIndex(old));
+    CHECK(engine::entityGeneration(reused) == engine::entityGeneration(old) + 1);
+    CHECK(world.isAlive(reused));
+    CHECK_FALSE(world.isAlive(old));
+
+    // The stale handle must not alias the new entity's components
+    CHECK_FALSE(world.hasComponent<game::Transform>(old));
+    CHECK(world.hasComponent<game::Transform>(reused));
+
+    CHECK_FALSE(world.isAlive(engine::INVALID_ENTITY));
+    CHECK_FALSE(world.isAlive(engine::makeEntityId(1000, 0)));
+}
+
+TEST_CASE("Entity slots retire instead of wrapping their generation") {
+    engine::World world;
+    world.registerComponent<game::Transform>();
+    engine::EntityId neighbour = world.createEntity();
+
+    engine::EntityId first = world.createEntity();
+    engine::EntityId entity = first;
+    for (uint32_t i = 0; i < engine::ENTITY_GENERATION_MASK; ++i) {
+        world.destroyEntity(entity);
+        entity = world.createEntity();
+        REQUIRE(engine::entityIndex(entity) == engine::entityIndex(first));
+    }
+    CHECK(engine::entityGeneration(entity) == engine::ENTITY_GENERATION_MASK);
+
+    // The next bump would wrap to generation 0 and revive `first`
+    world.destroyEntity(entity);
+    engine::EntityId next = world.createEntity();
+    CHECK(engine::entityIndex(next) != engine::entityIndex(first));
+    CHECK_FALSE(world.isAlive(first));
+    CHECK_FALSE(world.isAlive(entity));
+    CHECK(world.getEntityAt(engine::entityIndex(first)) == engine::INVALID_ENTITY);
+    CHECK(world.getLivingEntityCount() == 2);
+
+    // Retired slots survive a snapshot and stay out of the free list
+    world.destroyEntity(neighbour);
+    std::vector<std::byte> snapshot;
+    world.saveSnapshot(snapshot);
+    engine::World restored;
+    restored.registerComponent<game::Transform>();
+    REQUIRE(restored.loadSnapshot(snapshot.data(), snapshot.size()));
+    CHECK(engine::entityIndex(restored.createEntity()) == engine::entityIndex(neighbour));
+    engine::EntityId minted = restored.createEntity();
+    CHECK(engine::entityIndex(minted) == restored.getSlotCount() - 1);
+    CHECK_FALSE(restored.isAlive(first));
+}
+
+TEST_CASE("Tag components live in the signature") {
+    engine::World world;
+    world.registerComponent<game::Transform>();
+    world.registerComponent<game::Player>();
+    world.registerComponent<game::Enemy>();
+
+    engine::EntityId player = world.createEntity();
+    world.addComponent(player, game::Transform{1.0f, 0.0f, 0.0f});
+    world.addComponent(player, game::Player{});
+
+    engine::EntityId enemy = world.createEntity();
+    world.addComponent(enemy, game::Transform{2.0f, 0.0f, 0.0f});
+    world.addComponent(enemy, game::Enemy{});
+
+    engine::EntityId marker = world.createEntity();
+    world.addComponent(marker, game::Enemy{});
+
+    CHECK(world.hasComponent<game::Player>(player));
+    CHECK_FALSE(world.hasComponent<game::Player>(enemy));
+    CHECK(world.getSignature(player).test(engine::getComponentTypeId<game::Player>()));
+
+    SUBCASE("Views filter on tags") {
+        int visited = 0;
+        world.view<game::Transform, game::Enemy>().each(
+            [&](engine::EntityId entity, game::Transform& transform, game::Enemy&) {
+            CHECK(entity == enemy);
+            CHECK(transform.x == 2.0f);
+            visited++;
+        });
+        CHECK(visited == 1);
+    }
+
+    SUBCASE("Tag-only views walk live entities") {
+        int visited = 0;
+        world.view<game::Enemy>().each([&](engine::EntityId, game::Enemy&) { visited++; });
+        CHECK(visited == 2);
+
+        world.destroyEntity(marker);
+        visited = 0;
+        world.view<game::Enemy>().each([&](engine::EntityId, game::Enemy&) { visited++; });
+        CHECK(visited == 1);
+    }
+
+    SUBCASE("Removing a tag clears the bit") {
+        world.removeComponent<game::Player>(player);
+        CHECK_FALSE(world.hasComponent<game::Player>(player));
+        CHECK(world.hasComponent<game::Transform>(player));
+    }
+}
+
+TEST_CASE("Parallel view iteration matches serial iteration") {
+    engine::ThreadPool pool(3);
+    engine::World serial;
+    engine::World parallel;
+    for (engine::World* world : {&serial, &parallel}) {
+        world->registerComponent<game::Transform>();
+        world->registerComponent<game::Velocity>();
+        world->registerComponent<game::Enemy>();
+        for (int i = 0; i < 5000; ++i) {
+            engine::EntityId entity = world->createEntity();
+            world->addComponent(entity, game::Transform{static_cast<float>(i), 0.0f, 0.0f});
+            if (i % 4 != 0) {
+                world->addComponent(entity, game::Velocity{0.5f, static_cast<float>(i)});
+            }
+            if (i % 7 == 0) {
+                world->addComponent(entity, game::Enemy{});
+            }
+        }
+    }
+
+    auto step = [](engine::EntityId, game::Transform& transform, game::Velocity& velocity) {
+        transform.x += velocity.vx;
+        transform.y += velocity.vy * 0.5f;
+    };
+    serial.view<game::Transform, game::Velocity>().each(step);
+    parallel.view<game::Transform, game::Velocity>().parallelEach(pool, step, 64);
+
+    bool identical = true;
+    serial.view<game::Transform>().each([&](engine::EntityId entity, game::Transform& transform) {
+        const auto& other = parallel.getComponent<game::Transform>(entity);
+        identical = identical && other.x == transform.x && other.y == transform.y;
+    });
+    CHECK(identical);
+
+    std::atomic<int> enemies{0};
+    parallel.view<game::Enemy>().parallelEach(pool, [&](engine::EntityId, game::Enemy&) {
+        enemies++;
+    }, 100);
+    CHECK(enemies == (5000 + 6) / 7);
+}